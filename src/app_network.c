@@ -22,19 +22,81 @@
 #include "app_network.h"
 #include "chip_configuration.h"
 #include "enc28j60.h"
+#include "fixed_address_memory.h"
+#include "http.h"
 #include "net.h"
+#include "prof.h"
 #include "spi.h"
+#include "sse.h"
+#include "stats.h"
+#include "telemetry.h"
+#include "timer.h"
+#include "www_pages.h"
+#include "www_routes.h"
 
 #include <string.h>
 
-static uint8_t my_macaddr[6] = {0x54, 0x55, 0x58, 0x10, 0x00, 0x24};
-static uint8_t my_ip[4] = {192, 168, 0, 4};
-static char baseurl[] = "http://192.168.0.4/";
+static uint8_t my_macaddr[ENC28J60_NUM_INTERFACES][6] = {
+  {NET_MAC_ADDR0, NET_MAC_ADDR1, NET_MAC_ADDR2,
+   NET_MAC_ADDR3, NET_MAC_ADDR4, NET_MAC_ADDR5},
+#if ENC28J60_NUM_INTERFACES > 1
+  {NET1_MAC_ADDR0, NET1_MAC_ADDR1, NET1_MAC_ADDR2,
+   NET1_MAC_ADDR3, NET1_MAC_ADDR4, NET1_MAC_ADDR5},
+#endif
+};
+static uint8_t my_ip[ENC28J60_NUM_INTERFACES][4] = {
+  {NET_IP_ADDR0, NET_IP_ADDR1, NET_IP_ADDR2, NET_IP_ADDR3},
+#if ENC28J60_NUM_INTERFACES > 1
+  {NET1_IP_ADDR0, NET1_IP_ADDR1, NET1_IP_ADDR2, NET1_IP_ADDR3},
+#endif
+};
+/* Control traffic stays on the first interface, so bulk telemetry on the
+ * second one does not delay it.
+ */
+#define APP_IFACE_CONTROL  0
+#define APP_IFACE_DATA     (ENC28J60_NUM_INTERFACES - 1)
+/* Telemetry is only streamed to a collector set up in system_config.h. */
+#if NET_FEATURE_UDP && defined(TELEMETRY_COLLECTOR_ADDR0)
+#  define APP_TELEMETRY 1
+#else
+#  define APP_TELEMETRY 0
+#endif
+#if APP_TELEMETRY
+static uint8_t telemetry_ip[4] = {
+  TELEMETRY_COLLECTOR_ADDR0, TELEMETRY_COLLECTOR_ADDR1,
+  TELEMETRY_COLLECTOR_ADDR2, TELEMETRY_COLLECTOR_ADDR3
+};
+#  ifndef TELEMETRY_COLLECTOR_PORT
+#    define TELEMETRY_COLLECTOR_PORT 5001
+#  endif
+#endif
+#define TELEMETRY_PORT 5001
+#define CONTROL_PORT 5002
+#define STATS_PORT 5003
+#define PROF_PORT 5004
+#define SPI_ACCOUNTING_PORT 5005
 
-#define BUFFER_SIZE 250
+/* Sized for the largest frame the enabled features build or read in it:
+ * the /stats response, otherwise the control request of the UDP services
+ * which also covers the event stream header. Checked where each of them
+ * is handled.
+ */
+#ifndef BUFFER_SIZE
+#  if NET_FEATURE_TCP_SERVER && STATS_ENABLED
+#    define BUFFER_SIZE 250
+#  else
+#    define BUFFER_SIZE 142
+#  endif
+#endif
+#if defined(FIXED_ADDRESS_MEMORY) && defined(__XC8)
+#  if BUFFER_SIZE + 1 > APP_NETWORK_BUFFER_MAX_SIZE
+#    error "Packet buffer does not fit into its bank"
+#  endif
+/* Bank of its own, see fixed_address_memory.h. */
+static unsigned char buf[BUFFER_SIZE + 1] @ APP_NETWORK_BUFFER_ADDRESS;
+#else
 static unsigned char buf[BUFFER_SIZE + 1];
-#define STR_BUFFER_SIZE 22
-static char strbuf[STR_BUFFER_SIZE + 1];
+#endif
 
 #if defined(__18F4550)
 #  define LED0_IO LATDbits.LD0
@@ -46,184 +108,679 @@ static char strbuf[STR_BUFFER_SIZE + 1];
 #  define LED2_IO LATCbits.LC6
 #endif
 
-/* The returned value is stored in the global var strbuf. */
-static uint8_t find_key_val(char *str, char *key) {
-  uint8_t found = 0;
-  uint8_t i = 0;
-  char *kp;
-  kp = key;
-  while (*str &&  *str != ' ' && found == 0) {
-    if (*str == *kp) {
-      kp++;
-      if (*kp == '\0') {
-        str++;
-        kp = key;
-        if (*str == '=') {
-          found = 1;
-        }
-      }
-    } else {
-      kp = key;
+#if NET_FEATURE_TCP_SERVER
+/* Address of every interface as a base URL, set by www_set_address(). */
+static char baseurl[ENC28J60_NUM_INTERFACES][sizeof("http://255.255.255.255/")];
+/* Values of the {{field}} placeholders of the pages from www, pages are
+ * rendered with the fields of the interface they are sent on.
+ */
+static const char *page_fields[ENC28J60_NUM_INTERFACES][PAGE_NUM_FIELDS];
+#define WWW_FIELDS  page_fields[ENC28J60_Selected()]
+
+/* Must be called whenever the address of the interface is given to the
+ * stack, pages rendered with the old one are dropped from the cache.
+ */
+static void www_set_address(uint8_t iface) {
+  char *p = baseurl[iface];
+  uint8_t i, value;
+  memcpy(p, "http://", 7);
+  p += 7;
+  for (i = 0; i < 4; i++) {
+    value = my_ip[iface][i];
+    if (value >= 100) {
+      *p++ = '0' + value / 100;
     }
-    str++;
-  }
-  if (found == 1) {
-    /* copy the value to a buffer and terminate it with '\0' */
-    while (*str &&  *str != ' ' && *str != '&' && i < STR_BUFFER_SIZE) {
-      strbuf[i] = *str;
-      i++;
-      str++;
+    if (value >= 10) {
+      *p++ = '0' + value / 10 % 10;
     }
-    strbuf[i] = '\0';
+    *p++ = '0' + value % 10;
+    *p++ = (i == 3) ? '/' : '.';
+  }
+  *p = '\0';
+  page_fields[iface][PAGE_FIELD_BASEURL] = baseurl[iface];
+  NET_page_cache_flush();
+}
+
+/* Requests are parsed straight from the receive buffer in small chunks. */
+#define HTTP_CHUNK_SIZE 16
+static HTTP_PARSER http_parsers[NET_TCP_MAX_CONNECTIONS];
+
+static const char hex_digits[] = "0123456789abcdef";
+
+/* Responses to HEAD are the response header alone. */
+#define WWW_HEAD(parser) ((parser)->method == HTTP_METHOD_HEAD)
+
+/* Header-only response for a client which has the page already. */
+static void www_send_not_modified(int8_t conn, uint32_t etag) {
+  char tag[9];
+  uint16_t len;
+  uint8_t i;
+  for (i = 0; i < 8; i++) {
+    tag[i] = hex_digits[(etag >> (28 - 4 * i)) & 0x0f];
+  }
+  tag[8] = '\0';
+  len = NET_fill_tcp_data(buf, 0, "HTTP/1.0 304 Not Modified\r\nETag: \"");
+  len = NET_fill_tcp_data(buf, len, tag);
+  len = NET_fill_tcp_data(buf, len, "\"\r\n\r\n");
+  NET_tcp_send(conn,
+               buf,
+               TCP_FLAG_ACK_V | TCP_FLAG_PUSH_V | TCP_FLAG_FIN_V,
+               len);
+}
+
+/* Send compressed variant of the page when the client accepts it, or
+ * just 304 if the client has it cached already. Only GET and HEAD could
+ * be answered with 304.
+ */
+static void www_send_page(int8_t conn,
+                          const HTTP_PARSER *parser,
+                          const NET_PAGE *page) {
+  if (page->gzip != 0 && (parser->flags & HTTP_FLAG_ACCEPT_GZIP)) {
+    page = page->gzip;
   }
-  return found;
+  if ((parser->method == HTTP_METHOD_GET ||
+       parser->method == HTTP_METHOD_HEAD) &&
+      (parser->flags & HTTP_FLAG_IF_NONE_MATCH) &&
+      parser->if_none_match == page->etag)
+  {
+    www_send_not_modified(conn, page->etag);
+    return;
+  }
+  NET_tcp_send_page(conn, buf, page, WWW_FIELDS, WWW_HEAD(parser));
+}
+
+static uint8_t www_accept(int8_t conn) {
+  HTTP_Init(&http_parsers[conn]);
+  SSE_Unsubscribe(conn);
+  return 1;
 }
 
-static int8_t analyse_cmd(char *str) {
-  int8_t r = -1;
-  if (find_key_val(str, (char*)"cmd")) {
-    if (*strbuf < 0x3a && *strbuf > 0x2f) {
-      /* Is a ASCII number, return it. */
-      r = (*strbuf-0x30);
+/* Routes from routes.txt. */
+
+void APP_www_index(int8_t conn, uint8_t *buf, HTTP_PARSER *parser,
+                   const HTTP_PARAM *params, uint8_t num_params) {
+  const HTTP_PARAM *param;
+  uint16_t cmd;
+  param = HTTP_FindParam(params, num_params, "cmd");
+  if (param != 0 && HTTP_ParamUint(param, &cmd)) {
+    if (cmd == 2) {
+      LED2_IO = 1;
+      SSE_Changed();
+    } else if (cmd == 3) {
+      LED2_IO = 0;
+      SSE_Changed();
     }
   }
-  return r;
+  /* Each state of the LED is a page of its own with its own tag, so the
+   * tag follows the actual state of the LED.
+   */
+  www_send_page(conn, parser, LED2_IO ? &page_led_on : &page_led_off);
 }
 
-static uint16_t print_webpage(uint8_t *buf, uint8_t on_off) {
-  int i = 0;
-  uint16_t plen;
+void APP_www_style(int8_t conn, uint8_t *buf, HTTP_PARSER *parser,
+                   const HTTP_PARAM *params, uint8_t num_params) {
+  www_send_page(conn, parser, &page_style);
+}
 
-  plen = NET_fill_tcp_data_p(buf, 0, "HTTP/1.0 200 OK\r\nContent-Type: text/html\r\n\r\n");
-  plen = NET_fill_tcp_data_p(buf, plen, "<center><p><h1>Welcome to ETH28J60 Demo for PIC18F4550</h1></p> ");
-  plen = NET_fill_tcp_data_p(buf, plen, "<hr><br><form METHOD=get action=\"");
-  plen = NET_fill_tcp_data(buf, plen, baseurl);
-  plen = NET_fill_tcp_data_p(buf, plen, "\">");
-  plen = NET_fill_tcp_data_p(buf, plen, "<h2> REMOTE LED is  </h2> ");
-  plen = NET_fill_tcp_data_p(buf, plen, "<h1><font color=\"#00FF00\"> ");
-  if (on_off) {
-    plen = NET_fill_tcp_data_p(buf, plen, "ON");
-  } else {
-    plen = NET_fill_tcp_data_p(buf, plen, "OFF");
+/* The header of the event stream is 77 characters long. */
+#if TCP_DATA_P + 77 > BUFFER_SIZE + 1
+#  error "Event stream header does not fit into the packet buffer"
+#endif
+#if SSE_MAX_SUBSCRIBERS >= NET_TCP_MAX_CONNECTIONS
+#  error "Event streams would take every connection"
+#endif
+
+void APP_www_events(int8_t conn, uint8_t *buf, HTTP_PARSER *parser,
+                    const HTTP_PARAM *params, uint8_t num_params) {
+  if (WWW_HEAD(parser)) {
+    SSE_Head(conn, buf);
+  } else if (!SSE_Subscribe(conn, buf)) {
+    NET_tcp_send_page(conn, buf, &page_503, WWW_FIELDS, 0);
+  }
+}
+
+void APP_www_stats(int8_t conn, uint8_t *buf, HTTP_PARSER *parser,
+                   const HTTP_PARAM *params, uint8_t num_params) {
+#if STATS_ENABLED
+  /* The header below is 51 characters long. */
+#  if TCP_DATA_P + 51 + STATS_JSON_MAX_LEN + 1 > BUFFER_SIZE + 1
+#    error "Statistics do not fit into the packet buffer"
+#  endif
+  uint16_t len;
+  len = NET_fill_tcp_data(buf, 0, "HTTP/1.0 200 OK\r\n"
+                                    "Content-Type: application/json\r\n\r\n");
+  if (!WWW_HEAD(parser)) {
+    len += STATS_Json((char *)&buf[TCP_DATA_P + len]);
+  }
+  NET_tcp_send(conn,
+               buf,
+               TCP_FLAG_ACK_V | TCP_FLAG_PUSH_V | TCP_FLAG_FIN_V,
+               len);
+#else
+  NET_tcp_send_page(conn, buf, &page_404, WWW_FIELDS, WWW_HEAD(parser));
+#endif
+}
+
+/* Data of the events pushed to /events subscribers. */
+static uint8_t www_event(char *data) {
+  strcpy(data, "{\"led\":[0,0,0]}");
+  data[8] += LED0_IO;
+  data[10] += LED1_IO;
+  data[12] += LED2_IO;
+  return 15;
+}
+
+/* Read query and body of the parsed request back from the receive buffer,
+ * joined with '&'. Returns length of the query.
+ */
+static uint8_t www_read_query(const HTTP_PARSER *parser, char *query) {
+  uint8_t len = parser->query_len;
+  if (len != 0) {
+    ENC28J60_PacketRead(parser->query_pos, len, (uint8_t *)query);
+  }
+  if (parser->body_len != 0) {
+    if (len != 0) {
+      query[len++] = '&';
+    }
+    ENC28J60_PacketRead(parser->body_pos,
+                        parser->body_len,
+                        (uint8_t *)&query[len]);
+    len += parser->body_len;
+  }
+  return len;
+}
+
+/* Data received on the www port. */
+static void www_receive(int8_t conn, uint8_t *buf) {
+  HTTP_PARSER *parser = &http_parsers[conn];
+  const HTTP_ROUTE *route;
+  HTTP_PARAM params[HTTP_MAX_PARAMS];
+  uint8_t num_params;
+  uint8_t chunk[HTTP_CHUNK_SIZE + 1];
+  char query[HTTP_MAX_QUERY];
+  uint16_t pos, len, n;
+  uint8_t status = HTTP_PARSE_MORE;
+
+  NET_init_len_info(buf);
+  pos = NET_get_tcp_data_pointer();
+  len = NET_tcp_get_dlength(buf);
+  /* Length comes from the IP header, the data never goes past the frame
+   * we have received.
+   */
+  n = ENC28J60_PacketLength();
+  if (pos >= n) {
+    len = 0;
+  } else if (len > n - pos) {
+    len = n - pos;
+  }
+  HTTP_NextSegment(parser);
+  while (len != 0 && status == HTTP_PARSE_MORE) {
+    n = (len > HTTP_CHUNK_SIZE) ? HTTP_CHUNK_SIZE : len;
+    ENC28J60_PacketRead(pos, n, chunk);
+    status = HTTP_Parse(parser, chunk, n, pos);
+    pos += n;
+    len -= n;
+  }
+  if (status == HTTP_PARSE_MORE || status == HTTP_PARSE_OVER) {
+    /* Rest of the request is in the next segments, or the request is
+     * answered already and whatever comes after it is only acknowledged.
+     */
+    NET_tcp_send(conn, buf, TCP_FLAG_ACK_V, 0);
+    return;
+  }
+  if (status == HTTP_PARSE_ERROR || (parser->flags & HTTP_FLAG_QUERY_LOST)) {
+    /* Garbage, or parameters which are not in the receive buffer any more.
+     * The page closes the connection as any other one, the parser ignores
+     * whatever the client sends after it.
+     */
+    NET_tcp_send_page(conn, buf, &page_400, WWW_FIELDS, WWW_HEAD(parser));
+    return;
   }
-  plen = NET_fill_tcp_data_p(buf, plen, "  </font></h1><br> ");
-  if (on_off) {
-    plen = NET_fill_tcp_data_p(buf, plen, "<input type=hidden name=cmd value=3>");
-    plen = NET_fill_tcp_data_p(buf, plen, "<input type=submit value=\"Switch off\"></form>");
+  route = WWW_FindRoute(parser);
+  if (route == 0) {
+    NET_tcp_send_page(conn, buf, &page_404, WWW_FIELDS, WWW_HEAD(parser));
+  } else if ((route->methods & HTTP_METHOD_MASK(parser->method)) == 0) {
+    NET_tcp_send_page(conn, buf, &page_405, WWW_FIELDS, WWW_HEAD(parser));
   } else {
-    plen = NET_fill_tcp_data_p(buf, plen, "<input type=hidden name=cmd value=2>");
-    plen = NET_fill_tcp_data_p(buf, plen, "<input type=submit value=\"Switch on\"></form>");
+    num_params = HTTP_ParseQuery(query, www_read_query(parser, query),
+                                 params, HTTP_MAX_PARAMS);
+    route->handler(conn, buf, parser, params, num_params);
+  }
+}
+#endif  /* NET_FEATURE_TCP_SERVER */
+
+#if NET_FEATURE_UDP
+/* Binary control protocol on the UDP port CONTROL_PORT.
+ *
+ * Request:  version, seq (2 bytes), count, then count commands of
+ *           op, register, value.
+ * Response: version, seq (2 bytes), count, then count results of
+ *           status, register, value.
+ *
+ * Response to the request with the same seq from the same client is sent
+ * again without executing the commands, so requests could be retried
+ * safely. Only the last response is kept.
+ */
+#define CONTROL_VERSION       1
+#define CONTROL_HEADER_LEN    4
+#define CONTROL_MAX_COMMANDS  32
+
+#define CONTROL_OP_GET  0
+#define CONTROL_OP_SET  1
+
+#define CONTROL_STATUS_OK         0
+#define CONTROL_STATUS_BAD_REG    1
+#define CONTROL_STATUS_BAD_OP     2
+
+enum {
+  CONTROL_REG_LED0 = 0,
+  CONTROL_REG_LED1,
+  CONTROL_REG_LED2,
+  CONTROL_REG_CHIP_REV,
+  CONTROL_REG_UPTIME_L,
+  CONTROL_REG_UPTIME_H
+};
+
+#define CONTROL_DATA_LEN  (CONTROL_HEADER_LEN + CONTROL_MAX_COMMANDS * 3)
+#if UDP_DATA_P + CONTROL_DATA_LEN > BUFFER_SIZE
+#  error "Control request does not fit into the packet buffer"
+#endif
+
+/* The last response stays in the buffer memory as a complete frame. */
+static NET_UDP_STREAM control_stream;
+static uint8_t control_ip[4];
+static uint16_t control_port;
+static uint16_t control_seq;
+static uint8_t control_valid = 0;
+
+static uint8_t control_execute(uint8_t *command) {
+  uint8_t reg = command[1];
+  uint8_t value = command[2];
+  if (command[0] == CONTROL_OP_SET) {
+    switch (reg) {
+      case CONTROL_REG_LED0: LED0_IO = (value != 0); break;
+      case CONTROL_REG_LED1: LED1_IO = (value != 0); break;
+      case CONTROL_REG_LED2: LED2_IO = (value != 0); break;
+      case CONTROL_REG_CHIP_REV:
+      case CONTROL_REG_UPTIME_L:
+      case CONTROL_REG_UPTIME_H:
+        return CONTROL_STATUS_BAD_OP;
+      default:
+        return CONTROL_STATUS_BAD_REG;
+    }
+#if NET_FEATURE_TCP_SERVER
+    SSE_Changed();
+#endif
+  } else if (command[0] != CONTROL_OP_GET) {
+    return CONTROL_STATUS_BAD_OP;
+  }
+  switch (reg) {
+    case CONTROL_REG_LED0: value = LED0_IO; break;
+    case CONTROL_REG_LED1: value = LED1_IO; break;
+    case CONTROL_REG_LED2: value = LED2_IO; break;
+    case CONTROL_REG_CHIP_REV: value = ENC28J60_GetRev(); break;
+    case CONTROL_REG_UPTIME_L: value = TIMER_GetSeconds() & 0xff; break;
+    case CONTROL_REG_UPTIME_H: value = TIMER_GetSeconds() >> 8; break;
+    default:
+      return CONTROL_STATUS_BAD_REG;
   }
-  return plen;
+  command[2] = value;
+  return CONTROL_STATUS_OK;
 }
 
+static void control_receive(uint8_t *buf, uint16_t plen) {
+  uint8_t *data = &buf[UDP_DATA_P];
+  uint8_t *command;
+  uint16_t seq, port;
+  uint8_t i, count;
+  if (ENC28J60_Selected() != APP_IFACE_CONTROL) {
+    return;
+  }
+  plen = NET_udp_fetch(buf, BUFFER_SIZE + 1);
+  if (plen < CONTROL_HEADER_LEN || data[0] != CONTROL_VERSION ||
+      control_stream.slot == ENC28J60_NO_MEMORY)
+  {
+    return;
+  }
+  port = (buf[UDP_SRC_PORT_H_P] << 8) | buf[UDP_SRC_PORT_L_P];
+  seq = (data[1] << 8) | data[2];
+  if (control_valid && seq == control_seq && port == control_port &&
+      memcmp(control_ip, &buf[IP_SRC_P], 4) == 0)
+  {
+    /* Retry, our response got lost. */
+    ENC28J60_PacketTransmit(control_stream.slot,
+                            UDP_DATA_P + control_stream.len);
+    return;
+  }
+  count = data[3];
+  if (count > CONTROL_MAX_COMMANDS) {
+    count = CONTROL_MAX_COMMANDS;
+  }
+  if (count > (plen - CONTROL_HEADER_LEN) / 3) {
+    count = (plen - CONTROL_HEADER_LEN) / 3;
+  }
+  data[3] = count;
+  /* Results replace the commands in place. */
+  for (i = 0; i < count; i++) {
+    command = &data[CONTROL_HEADER_LEN + i * 3];
+    command[0] = control_execute(command);
+  }
+  control_valid = 0;
+  if (!NET_udp_stream_begin(&control_stream,
+                            control_stream.slot,
+                            &buf[IP_SRC_P],
+                            port,
+                            CONTROL_PORT))
+  {
+    return;
+  }
+  NET_udp_stream_write(&control_stream, data, CONTROL_HEADER_LEN + count * 3);
+  NET_udp_stream_send(&control_stream);
+  memcpy(control_ip, &buf[IP_SRC_P], 4);
+  control_port = port;
+  control_seq = seq;
+  control_valid = 1;
+}
+
+#if STATS_ENABLED
+/* Any datagram on STATS_PORT is answered with the snapshot of the
+ * counters, see stats.h. Counters are cleared after the answer if the
+ * first data byte is non-zero, so they could be sampled per interval.
+ */
+static void stats_receive(uint8_t *buf, uint16_t plen) {
+  uint8_t snapshot[STATS_ENCODED_LEN];
+  uint8_t len;
+  plen = NET_udp_fetch(buf, BUFFER_SIZE + 1);
+  len = STATS_Encode(snapshot);
+  NET_make_udp_reply_from_request(buf,
+                                  (const char *)snapshot,
+                                  len,
+                                  (buf[UDP_SRC_PORT_H_P] << 8) |
+                                  buf[UDP_SRC_PORT_L_P]);
+  if (plen != 0 && buf[UDP_DATA_P] != 0) {
+    STATS_Reset();
+  }
+}
+#endif
+
+#if PROF_ENABLED
+/* Any datagram on PROF_PORT is answered with the number of sections and
+ * every section encoded by PROF_Encode(). Sections are cleared after the
+ * answer if the first data byte is non-zero.
+ */
+static void prof_receive(uint8_t *buf, uint16_t plen) {
+  uint8_t section[PROF_SECTION_ENCODED_LEN];
+  uint8_t i, len;
+  plen = NET_udp_fetch(buf, BUFFER_SIZE + 1);
+  if (!NET_udp_begin(&buf[IP_SRC_P],
+                     (buf[UDP_SRC_PORT_H_P] << 8) | buf[UDP_SRC_PORT_L_P],
+                     PROF_PORT))
+  {
+    return;
+  }
+  section[0] = PROF_NUM_SECTIONS;
+  NET_udp_write(section, 1);
+  for (i = 0; i < PROF_NUM_SECTIONS; i++) {
+    len = PROF_Encode(i, section);
+    NET_udp_write(section, len);
+  }
+  NET_udp_send();
+  if (plen != 0 && buf[UDP_DATA_P] != 0) {
+    PROF_Reset();
+  }
+}
+#endif
+
+#if SPI_ACCOUNTING
+/* Any datagram on SPI_ACCOUNTING_PORT is answered with the number of
+ * categories and every account encoded by SPI_EncodeAccount().
+ */
+static void spi_accounting_receive(uint8_t *buf, uint16_t plen) {
+  uint8_t account[SPI_ACCOUNT_ENCODED_LEN];
+  uint8_t i, len;
+  (void)plen;
+  if (!NET_udp_begin(&buf[IP_SRC_P],
+                     (buf[UDP_SRC_PORT_H_P] << 8) | buf[UDP_SRC_PORT_L_P],
+                     SPI_ACCOUNTING_PORT))
+  {
+    return;
+  }
+  account[0] = SPI_NUM_CATEGORIES;
+  NET_udp_write(account, 1);
+  for (i = 0; i < SPI_NUM_CATEGORIES; i++) {
+    len = SPI_EncodeAccount(i, account);
+    NET_udp_write(account, len);
+  }
+  NET_udp_send();
+}
+#endif
+#endif  /* NET_FEATURE_UDP */
+
+#if APP_TELEMETRY
+/* Uptime and LED state are sampled every TELEMETRY_SAMPLE_PERIOD
+ * milliseconds and streamed to the telemetry collector.
+ */
+#ifndef TELEMETRY_SAMPLE_PERIOD
+#  define TELEMETRY_SAMPLE_PERIOD 100
+#endif
+#if TELEMETRY_SAMPLE_SIZE < 5
+#  error "Sample does not fit uptime and LED state"
+#endif
+static uint16_t sample_time;
+
+static void app_sample(void) {
+  uint8_t sample[TELEMETRY_SAMPLE_SIZE];
+  uint16_t now = TIMER_GetMillis();
+  uint16_t seconds;
+  if ((uint16_t)(now - sample_time) < TELEMETRY_SAMPLE_PERIOD) {
+    return;
+  }
+  sample_time = now;
+  seconds = TIMER_GetSeconds();
+  memset(sample, 0, sizeof(sample));
+  sample[0] = now >> 8;
+  sample[1] = now & 0xff;
+  sample[2] = seconds >> 8;
+  sample[3] = seconds & 0xff;
+  sample[4] = LED0_IO | (LED1_IO << 1) | (LED2_IO << 2);
+  TELEMETRY_Sample(sample);
+}
+#endif
+
+/* Startup is a state machine stepped from APP_network_loop(), so nothing
+ * blocks and the stack answers ARP as soon as reception is enabled.
+ */
+enum {
+  APP_STATE_RESET = 0,  /* Hardware reset is done, soft reset is next. */
+  APP_STATE_CLOCK,      /* Waiting for the controller clock. */
+  APP_STATE_CLKOUT,     /* Waiting for CLKOUT to settle. */
+  APP_STATE_RUNNING
+};
+
+/* Time CLKOUT is given to settle after its frequency is changed, in
+ * milliseconds.
+ */
+#define APP_CLKOUT_DELAY 10
+
+/* Light both LEDs of the module for a second after startup. */
+#ifndef APP_DEBUG_BLINK
+#  define APP_DEBUG_BLINK 0
+#endif
+#define APP_BLINK_TIME 1000
+
+static uint8_t app_state;
+static uint16_t app_time;
+/* Interface the startup is at, all of them go through each state. */
+static uint8_t app_iface;
+#if APP_DEBUG_BLINK
+static uint8_t app_blinking = 0;
+#endif
+
+/* Handlers registered below: ARP, ICMP and every UDP service. Failing
+ * registration is caught here since there is nothing to do about it at
+ * run time.
+ */
+#define APP_NUM_HANDLERS \
+  (1 + NET_FEATURE_ICMP + \
+   NET_FEATURE_UDP * (1 + STATS_ENABLED + PROF_ENABLED + SPI_ACCOUNTING))
+#if APP_NUM_HANDLERS > NET_MAX_HANDLERS
+#  error "Packet handlers do not fit into NET_MAX_HANDLERS"
+#endif
 
 void APP_network_init(void) {
-  uint8_t a;
   LED0_IO = 0;
   LED1_IO = 1;
   LED2_IO = 0;
 
+  /* Reset pulse only has to be 400ns long, SPI setup covers it. */
   LATBbits.LB4 = 0;  /* Reset the module. */
   LATBbits.LB5 = 0;
-  __delay_ms(10);
-
   SPI_Init();
   LATBbits.LB4 = 1;  /* Resume the module. */
   LATBbits.LB5 = 1;
 
-  ENC28J60_Init(my_macaddr);
-  ENC28J60_ClkOut(2);
-  __delay_ms(10);
-
-  LED0_IO = 1;
+  /* Everything which does not touch the controller is set up while its
+   * oscillator starts.
+   */
+  for (app_iface = 0; app_iface < ENC28J60_NUM_INTERFACES; app_iface++) {
+    ENC28J60_Select(app_iface);
+    NET_init(my_macaddr[app_iface], my_ip[app_iface]);
+#if NET_FEATURE_TCP_SERVER
+    www_set_address(app_iface);
+#endif
+  }
+  /* arp is broadcast if unknown but a host may also verify the mac address by
+   * sending it to a unicast address.
+   */
+  NET_register_handler(NET_PROTO_ARP, 0, NET_handle_arp);
+#if NET_FEATURE_ICMP
+  NET_register_handler(NET_PROTO_ICMP, 0, NET_handle_icmp);
+#endif
+#if NET_FEATURE_TCP_SERVER
+  NET_tcp_listen(80, NET_TCP_MAX_CONNECTIONS, www_accept, www_receive);
+  SSE_Init(www_event);
+#endif
+#if NET_FEATURE_UDP
+  NET_udp_bind(CONTROL_PORT, control_receive);
+#  if STATS_ENABLED
+  NET_udp_bind(STATS_PORT, stats_receive);
+#  endif
+#  if PROF_ENABLED
+  NET_udp_bind(PROF_PORT, prof_receive);
+#  endif
+#  if SPI_ACCOUNTING
+  NET_udp_bind(SPI_ACCOUNTING_PORT, spi_accounting_receive);
+#  endif
+#endif
 
-  /* Debug blink: keep both LEDs on for a bit. */
-  ENC28J60_PhyWrite(PHLCON, 0x880);
-  for (a = 0; a < 100; ++a)  __delay_ms(10);
+  app_state = APP_STATE_RESET;
+  app_time = TIMER_GetMillis();
+}
 
-  /* LEDA=links status, LEDB=receive/transmit. */
-  ENC28J60_PhyWrite(PHLCON, 0x476);
-  LED2_IO = 1;
-  NET_init(my_macaddr, my_ip, 80);
+/* Returns non-zero once the stack is up. */
+static uint8_t app_startup(void) {
+  uint16_t elapsed = TIMER_GetMillis() - app_time;
+  switch (app_state) {
+    case APP_STATE_RESET:
+      if (elapsed > ENC28J60_RESET_DELAY) {
+        for (app_iface = 0; app_iface < ENC28J60_NUM_INTERFACES; app_iface++) {
+          ENC28J60_Select(app_iface);
+          ENC28J60_Reset();
+        }
+        app_iface = 0;
+        app_time = TIMER_GetMillis();
+        app_state = APP_STATE_CLOCK;
+      }
+      return 0;
+    case APP_STATE_CLOCK:
+      /* Controllers are configured one by one as their clock is ready. */
+      ENC28J60_Select(app_iface);
+      if (elapsed <= ENC28J60_RESET_DELAY || !ENC28J60_IsReady()) {
+        return 0;
+      }
+      ENC28J60_Configure(my_macaddr[app_iface]);
+#if APP_DEBUG_BLINK
+      /* Debug blink: keep both LEDs on for a bit. */
+      ENC28J60_PhyWrite(PHLCON, 0x880);
+#else
+      /* LEDA=links status, LEDB=receive/transmit. */
+      ENC28J60_PhyWrite(PHLCON, 0x476);
+#endif
+#if NET_FEATURE_UDP
+      /* Buffer memory is allocated once the controller is configured. */
+#  if APP_TELEMETRY
+      if (app_iface == APP_IFACE_DATA) {
+        TELEMETRY_Init(telemetry_ip, TELEMETRY_COLLECTOR_PORT, TELEMETRY_PORT);
+      }
+#  endif
+      if (app_iface == APP_IFACE_CONTROL) {
+        control_stream.slot = ENC28J60_MemAlloc(
+            ENC28J60_TX_SLOT_SIZE(UDP_DATA_P + CONTROL_DATA_LEN));
+      }
+#endif
+      if (++app_iface != ENC28J60_NUM_INTERFACES) {
+        return 0;
+      }
+      /* Only the first controller clocks the board. */
+      ENC28J60_Select(0);
+      ENC28J60_ClkOut(2);
+      app_time = TIMER_GetMillis();
+      app_state = APP_STATE_CLKOUT;
+      return 0;
+    case APP_STATE_CLKOUT:
+      if (elapsed < APP_CLKOUT_DELAY) {
+        return 0;
+      }
+      LED0_IO = 1;
+#if APP_DEBUG_BLINK
+      app_blinking = 1;
+      app_time = TIMER_GetMillis();
+#endif
+      LED2_IO = 1;
+      app_state = APP_STATE_RUNNING;
+      return 1;
+  }
+  return 1;
 }
 
 void APP_network_loop(void) {
-  uint16_t plen, dat_p;
-  int8_t cmd;
-  uint8_t on_off = 1;
-
-  plen = ENC28J60_PacketReceive(BUFFER_SIZE, buf);
-  /* plen will be unequal to zero if there is a valid packet
-   * (without crc error)
+  uint16_t plen;
+  if (app_state != APP_STATE_RUNNING && !app_startup()) {
+    return;
+  }
+#if APP_DEBUG_BLINK
+  if (app_blinking &&
+      (uint16_t)(TIMER_GetMillis() - app_time) >= APP_BLINK_TIME)
+  {
+    for (app_iface = 0; app_iface < ENC28J60_NUM_INTERFACES; app_iface++) {
+      ENC28J60_Select(app_iface);
+      /* LEDA=links status, LEDB=receive/transmit. */
+      ENC28J60_PhyWrite(PHLCON, 0x476);
+    }
+    app_blinking = 0;
+  }
+#endif
+  /* A packet is taken from every interface in turn, replies go out on the
+   * interface the packet came from.
    */
-  if (plen != 0) {
-    /* arp is broadcast if unknown but a host may also verify the mac address by
-     * sending it to a unicast address.
+  for (app_iface = 0; app_iface < ENC28J60_NUM_INTERFACES; app_iface++) {
+    ENC28J60_Select(app_iface);
+    /* Only the headers are read at first, the rest of the packet stays in
+     * the receive buffer until we know it is needed.
      */
-    if (NET_eth_type_is_arp_and_my_ip(buf, plen)) {
-      NET_make_arp_answer_from_request(buf);
-      return;
-    }
-
-    /* Check if ip packets are for us. */
-    if (NET_eth_type_is_ip_and_my_ip(buf, plen) == 0) {
-      return;
-    }
-
-    if (buf[IP_PROTO_P] == IP_PROTO_ICMP_V &&
-        buf[ICMP_TYPE_P] == ICMP_TYPE_ECHOREQUEST_V)
-    {
-      NET_make_echo_reply_from_request(buf, plen);
-      return;
-    }
-
-    /* tcp port www start, compare only the lower byte. */
-    if (buf[IP_PROTO_P] == IP_PROTO_TCP_V &&
-        buf[TCP_DST_PORT_H_P] == 0 &&
-        buf[TCP_DST_PORT_L_P] == 80)
-    {
-      if (buf[TCP_FLAGS_P] & TCP_FLAGS_SYN_V) {
-        /* NET_make_tcp_synack_from_syn does already send the syn, ack. */
-        NET_make_tcp_synack_from_syn(buf);
-        return;
-      }
-      if (buf[TCP_FLAGS_P] & TCP_FLAGS_ACK_V) {
-        NET_init_len_info(buf);  /* Init some data structures. */
-        dat_p = NET_get_tcp_data_pointer();
-        if (dat_p == 0) {  /* we can possibly have no data, just ack. */
-          if (buf[TCP_FLAGS_P] & TCP_FLAGS_FIN_V) {
-            NET_make_tcp_ack_from_any(buf);
-          }
-          return;
-        }
-        if (strncmp("GET ", (char *)&(buf[dat_p]), 4) != 0) {
-          /* head, post and other methods for possible status codes see:
-           *   http://www.w3.org/Protocols/rfc2616/rfc2616-sec10.html
-           */
-          plen = NET_fill_tcp_data_p(
-              buf,
-              0,
-              "HTTP/1.0 200 OK\r\nContent-Type: text/html\r\n\r\n<h1>200 OK</h1>");
-          goto SENDTCP;
-        }
-        if (strncmp("/ ", (char *)&(buf[dat_p + 4]), 2) == 0) {
-          plen = print_webpage(buf, on_off);
-          goto SENDTCP;
-        }
-        cmd = analyse_cmd((char *)&(buf[dat_p + 5]));
-        if (cmd == 2) {
-          on_off = 1;
-          LED2_IO = 1;
-        } else if (cmd == 3) {
-          on_off = 0;
-          LED2_IO = 0;
-        }
-        plen = print_webpage(buf, on_off);
-SENDTCP:
-        NET_make_tcp_ack_from_any(buf);  /* Send ack for http get. */
-        NET_make_tcp_ack_with_data(buf, plen);  /* send data. */
-      }
+    plen = ENC28J60_PacketReceive(TCP_DATA_P + 1, buf);
+    /* plen will be unequal to zero if there is a valid packet
+     * (without crc error)
+     */
+    if (plen != 0) {
+      NET_dispatch(buf, plen);
     }
   }
+#if APP_TELEMETRY
+  app_sample();
+  TELEMETRY_Tasks();
+#endif
+#if NET_FEATURE_TCP_SERVER
+  SSE_Tasks(buf);
+#endif
 }
@@ -79,6 +79,9 @@
 #if defined(__18F4550) || defined(__18F2550)
 #  define SSP_CS_TRIS    TRISAbits.TRISA5
 #  define SSP_CS_IO      LATAbits.LA5
+/* Chip select of the second ENC28J60, see ENC28J60_NUM_INTERFACES. */
+#  define SSP_CS1_TRIS   TRISAbits.TRISA4
+#  define SSP_CS1_IO     LATAbits.LA4
 #  define SSP_SDI_TRIS   TRISBbits.TRISB0
 #  define SSP_SCK_TRIS   TRISBbits.TRISB1
 #  define SSP_SDO_TRIS   TRISCbits.TRISC7
@@ -33,17 +33,60 @@
 
 #include "chip_configuration.h"
 #include "io_mapping.h"
+#include "prof.h"
 #include "spi.h"
+#include "stats.h"
 
-static uint8_t Enc28j60Bank = 0xffffff;
-static uint16_t NextPacketPtr;
+#if ENC28J60_MEM_BLOCKS > 16
+#  error "Memory bitmap is too small"
+#endif
+
+/* State of a single controller. */
+typedef struct {
+  /* Register bank selected in the controller. */
+  uint8_t bank;
+  uint16_t next_packet_ptr;
+  /* The received packet stays in the receive buffer until the next packet
+   * is requested, so parts of it could be read or DMA copied later.
+   */
+  uint8_t packet_pending;
+  uint16_t packet_addr;
+  uint16_t packet_len;
+  /* Allocated blocks of the buffer memory, one bit per block. */
+  uint16_t mem_used;
+  uint16_t tx_slot;
+} ENC28J60_STATE;
+
+static ENC28J60_STATE States[ENC28J60_NUM_INTERFACES];
+#if ENC28J60_NUM_INTERFACES > 1
+/* Controller all the functions work with, see ENC28J60_Select(). */
+static ENC28J60_STATE *State = &States[0];
+static uint8_t Selected = 0;
+#else
+#  define State (&States[0])
+#endif
+
+#if ENC28J60_NUM_INTERFACES > 1
+/* Direct all the following calls to the given controller. */
+void ENC28J60_Select(uint8_t iface) {
+  State = &States[iface];
+  Selected = iface;
+  SPI_Select(iface);
+}
+
+uint8_t ENC28J60_Selected(void) {
+  return Selected;
+}
+#endif
 
 void ENC28J60_WriteOp(uint8_t op, uint8_t addr, uint8_t data) {
   SPI_Write(op | (addr & ADDR_MASK), data);
 }
 
 uint8_t ENC28J60_ReadOp(uint8_t op, uint8_t addr) {
-  SSP_CS_IO = 0;  /* Activate the SS SPI Select pin. */
+  /* MAC and MII registers take a dummy byte. */
+  SPI_ACCOUNT(SPI_Category, 2 + (addr >> 7));
+  SPI_CS_ASSERT();  /* Activate the SS SPI Select pin. */
   SSPBUF = op | (addr & ADDR_MASK);  /* Start register address transmission */
   while (!PIR1bits.SSPIF);  /* Wait for Data Transmit/Receipt complete. */
   PIR1bits.SSPIF = 0;
@@ -56,16 +99,17 @@ uint8_t ENC28J60_ReadOp(uint8_t op, uint8_t addr) {
     while (!PIR1bits.SSPIF);  /* Wait for Data Transmit/Receipt complete. */
     PIR1bits.SSPIF = 0;
   }
-  SSP_CS_IO = 1;  /* CS pin is not active. */
+  SPI_CS_RELEASE();  /* CS pin is not active. */
   return SSPBUF;
 }
 
 void ENC28J60_SetBank(uint8_t addr) {
   /* Set the bank if needed. */
-  if ((addr & BANK_MASK) != Enc28j60Bank) {
+  if ((addr & BANK_MASK) != State->bank) {
     ENC28J60_WriteOp(ENC28J60_BIT_FIELD_CLR, ECON1, (ECON1_BSEL1|ECON1_BSEL0));
     ENC28J60_WriteOp(ENC28J60_BIT_FIELD_SET, ECON1, (addr & BANK_MASK) >> 5);
-    Enc28j60Bank = (addr & BANK_MASK);
+    State->bank = (addr & BANK_MASK);
+    SPI_ACCOUNT_BANK_SWITCH();
   }
 }
 
@@ -80,6 +124,8 @@ void ENC28J60_Write(uint8_t addr, uint8_t data) {
 }
 
 void ENC28J60_PhyWrite(uint8_t addr, uint16_t data) {
+  uint8_t category = SPI_CATEGORY_SELECTED();
+  SPI_CATEGORY(SPI_CAT_PHY);
   /* Set the PHY register address. */
   ENC28J60_Write(MIREGADR, addr);
   /* Write the PHY data. */
@@ -89,37 +135,78 @@ void ENC28J60_PhyWrite(uint8_t addr, uint16_t data) {
   while (ENC28J60_Read(MISTAT) & MISTAT_BUSY) {
     __delay_us(15);
   }
+  SPI_CATEGORY(category);
 }
 
 uint8_t ENC28J60_GetRev(void) {
-  return ENC28J60_Read(EREVID);
+  uint8_t category = SPI_CATEGORY_SELECTED();
+  uint8_t rev;
+  SPI_CATEGORY(SPI_CAT_INIT);
+  rev = ENC28J60_Read(EREVID);
+  SPI_CATEGORY(category);
+  return rev;
 }
 
-void ENC28J60_Init(uint8_t *macaddr) {
-  /* Perform system reset. */
+/* Start system reset of the controller.
+ *
+ * CLKRDY is not valid right after the reset command, so ENC28J60_IsReady()
+ * is not to be asked earlier than ENC28J60_RESET_DELAY milliseconds later.
+ */
+void ENC28J60_Reset(void) {
+  uint8_t category = SPI_CATEGORY_SELECTED();
+  SPI_CATEGORY(SPI_CAT_INIT);
   ENC28J60_WriteOp(ENC28J60_SOFT_RESET, 0, ENC28J60_SOFT_RESET);
-  /* check CLKRDY bit to see if reset is complete */
-  __delay_ms(10);
-  while (!(ENC28J60_Read(ESTAT) & ESTAT_CLKRDY));
+  /* Reset clears ECON1, so bank 0 is selected again. */
+  State->bank = 0;
+  SPI_CATEGORY(category);
+}
+
+/* Non-zero once the clock is stable after reset. */
+uint8_t ENC28J60_IsReady(void) {
+  uint8_t category = SPI_CATEGORY_SELECTED();
+  uint8_t ready;
+  SPI_CATEGORY(SPI_CAT_INIT);
+  ready = (ENC28J60_Read(ESTAT) & ESTAT_CLKRDY) != 0;
+  SPI_CATEGORY(category);
+  return ready;
+}
+
+/* Blocking reset and configuration. */
+void ENC28J60_Init(uint8_t *macaddr) {
+  ENC28J60_Reset();
+  __delay_ms(ENC28J60_RESET_DELAY);
+  while (!ENC28J60_IsReady());
+  ENC28J60_Configure(macaddr);
+}
 
+/* Configure controller which is ready after reset, reception is enabled
+ * at the very end.
+ */
+void ENC28J60_Configure(uint8_t *macaddr) {
+  uint8_t category = SPI_CATEGORY_SELECTED();
+  SPI_CATEGORY(SPI_CAT_INIT);
   /* ** Do bank 0 stuff ** */
   /* Initialize receive buffer. 16-bit transfers, must write low byte first. */
-  NextPacketPtr = RXSTART_INIT;  /* set receive buffer start address. */
+  /* Set receive buffer start address. */
+  State->next_packet_ptr = RXSTART_INIT;
+  State->packet_pending = 0;
   /* Rx start. */
   ENC28J60_Write(ERXSTL, RXSTART_INIT & 0xff);
   ENC28J60_Write(ERXSTH, RXSTART_INIT >> 8);
-  /* Set receive pointer address. */
-  ENC28J60_Write(ERXRDPTL, RXSTART_INIT & 0xff);
-  ENC28J60_Write(ERXRDPTH, RXSTART_INIT >> 8);
+  /* Set receive pointer address, it must be odd. See Rev. B7 Silicon
+   * Errata.
+   */
+  ENC28J60_Write(ERXRDPTL, RXSTOP_INIT & 0xff);
+  ENC28J60_Write(ERXRDPTH, RXSTOP_INIT >> 8);
   /* RX end. */
   ENC28J60_Write(ERXNDL, RXSTOP_INIT & 0xff);
   ENC28J60_Write(ERXNDH, RXSTOP_INIT >> 8);
+  /* Space for one full ethernet frame, the rest of the memory is free. */
+  State->mem_used = 0;
+  State->tx_slot = ENC28J60_MemAlloc(ENC28J60_TX_SLOT_SIZE(MAX_FRAMELEN));
   /* TX start. */
-  ENC28J60_Write(ETXSTL, TXSTART_INIT & 0xff);
-  ENC28J60_Write(ETXSTH, TXSTART_INIT >> 8);
-  /* TX end. */
-  ENC28J60_Write(ETXNDL, TXSTOP_INIT & 0xff);
-  ENC28J60_Write(ETXNDH, TXSTOP_INIT >> 8);
+  ENC28J60_Write(ETXSTL, State->tx_slot & 0xff);
+  ENC28J60_Write(ETXSTH, State->tx_slot >> 8);
 
   /* Do bank 1 stuff, packet filter:
    * For broadcast packets we allow only ARP packtets
@@ -178,15 +265,20 @@ void ENC28J60_Init(uint8_t *macaddr) {
   ENC28J60_WriteOp(ENC28J60_BIT_FIELD_SET, EIE, EIE_INTIE|EIE_PKTIE);
   /* Enable packet reception. */
   ENC28J60_WriteOp(ENC28J60_BIT_FIELD_SET, ECON1, ECON1_RXEN);
+  SPI_CATEGORY(category);
 }
 
 void ENC28J60_ClkOut(uint8_t clk) {
+  uint8_t category = SPI_CATEGORY_SELECTED();
+  SPI_CATEGORY(SPI_CAT_INIT);
   /* Setup clkout: 2 is 12.5MHz: */
   ENC28J60_Write(ECOCON, clk & 0x7);
+  SPI_CATEGORY(category);
 }
 
 void ENC28J60_ReadBuffer(uint16_t len, uint8_t *data) {
-  SSP_CS_IO = 0;
+  SPI_ACCOUNT(SPI_CAT_RX_PAYLOAD, 1 + len);
+  SPI_CS_ASSERT();
   /* Issue read command */
   SSPBUF = ENC28J60_READ_BUF_MEM;
   while (!PIR1bits.SSPIF);
@@ -201,7 +293,64 @@ void ENC28J60_ReadBuffer(uint16_t len, uint8_t *data) {
   data++;
   }
   *data='\0';
-  SSP_CS_IO = 1;
+  SPI_CS_RELEASE();
+}
+
+/* Address of the given byte of the current packet in the buffer memory,
+ * taking receive buffer wrap around into account.
+ */
+uint16_t ENC28J60_PacketAddr(uint16_t offset) {
+  uint16_t addr = State->packet_addr + offset;
+  if (addr > RXSTOP_INIT) {
+    addr -= RXSTOP_INIT - RXSTART_INIT + 1;
+  }
+  return addr;
+}
+
+/* Full length of the current packet, not limited by maxlen. */
+uint16_t ENC28J60_PacketLength(void) {
+  return State->packet_len;
+}
+
+/* Read len bytes of the current packet starting at the given offset.
+ * Same as ENC28J60_ReadBuffer() data is zero-terminated.
+ */
+void ENC28J60_PacketRead(uint16_t offset, uint16_t len, uint8_t *data) {
+  uint16_t addr = ENC28J60_PacketAddr(offset);
+  uint8_t category = SPI_CATEGORY_SELECTED();
+  SPI_CATEGORY(SPI_CAT_RX_META);
+  ENC28J60_Write(ERDPTL, addr & 0xff);
+  ENC28J60_Write(ERDPTH, addr >> 8);
+  ENC28J60_ReadBuffer(len, data);
+  SPI_CATEGORY(category);
+}
+
+/* Free the memory of the current packet in the receive buffer. */
+void ENC28J60_PacketRelease(void) {
+  uint16_t addr;
+  uint8_t category;
+  if (!State->packet_pending) {
+    return;
+  }
+  category = SPI_CATEGORY_SELECTED();
+  SPI_CATEGORY(SPI_CAT_RX_META);
+  /* Move the RX read pointer right before the start of the next received
+   * packet. This frees the memory we just read out.
+   *
+   * ERXRDPT must be odd (see Rev. B7 Silicon Errata), packets
+   * always start at even address so that works out.
+   */
+  if (State->next_packet_ptr == RXSTART_INIT) {
+    addr = RXSTOP_INIT;
+  } else {
+    addr = State->next_packet_ptr - 1;
+  }
+  ENC28J60_Write(ERXRDPTL, addr & 0xff);
+  ENC28J60_Write(ERXRDPTH, addr >> 8);
+  /* Decrement the packet counter indicate we are done with this packet. */
+  ENC28J60_WriteOp(ENC28J60_BIT_FIELD_SET, ECON2, ECON2_PKTDEC);
+  State->packet_pending = 0;
+  SPI_CATEGORY(category);
 }
 
 /* Gets a packet from the network receive buffer, if one is available.
@@ -209,22 +358,36 @@ void ENC28J60_ReadBuffer(uint16_t len, uint8_t *data) {
  *      maxlen  The maximum acceptable length of a retrieved packet.
  *      packet  Pointer where packet data should be stored.
  * Returns: Packet length in bytes if a packet was retrieved, zero otherwise.
+ *
+ * The previous packet is released from the receive buffer by this call.
  */
 uint16_t ENC28J60_PacketReceive(uint16_t maxlen, uint8_t *packet) {
   uint16_t rxstat;
   uint16_t len;
+  uint8_t category = SPI_CATEGORY_SELECTED();
+  /* Not ended when there is no packet, so only receives are timed. */
+  PROF_BEGIN(PROF_RECEIVE);
+  ENC28J60_PacketRelease();
+  SPI_CATEGORY(SPI_CAT_RX_META);
   /* Check if a packet has been received and buffered. */
   // if(!(enc28j60Read(EIR) & EIR_PKTIF) ) {
   /* The above does not work. See Rev. B4 Silicon Errata point 6. */
   if (ENC28J60_Read(EPKTCNT) ==0) {
+    SPI_CATEGORY(category);
     return 0;
   }
   /* Set the read pointer to the start of the received packet. */
-  ENC28J60_Write(ERDPTL, (NextPacketPtr));
-  ENC28J60_Write(ERDPTH, (NextPacketPtr) >> 8);
+  ENC28J60_Write(ERDPTL, (State->next_packet_ptr));
+  ENC28J60_Write(ERDPTH, (State->next_packet_ptr) >> 8);
+  /* Frame data follows the 6 bytes of next packet pointer and status. */
+  State->packet_addr = State->next_packet_ptr + 6;
+  if (State->packet_addr > RXSTOP_INIT) {
+    State->packet_addr -= RXSTOP_INIT - RXSTART_INIT + 1;
+  }
+  State->packet_pending = 1;
   /* Read the next packet pointer. */
-  NextPacketPtr  = ENC28J60_ReadOp(ENC28J60_READ_BUF_MEM, 0);
-  NextPacketPtr |= ENC28J60_ReadOp(ENC28J60_READ_BUF_MEM, 0) << 8;
+  State->next_packet_ptr  = ENC28J60_ReadOp(ENC28J60_READ_BUF_MEM, 0);
+  State->next_packet_ptr |= ENC28J60_ReadOp(ENC28J60_READ_BUF_MEM, 0) << 8;
   /* Read the packet length (see datasheet page 43). */
   len  = ENC28J60_ReadOp(ENC28J60_READ_BUF_MEM, 0);
   len |= ENC28J60_ReadOp(ENC28J60_READ_BUF_MEM, 0) << 8;
@@ -232,6 +395,7 @@ uint16_t ENC28J60_PacketReceive(uint16_t maxlen, uint8_t *packet) {
   /* Read the receive status (see datasheet page 43). */
   rxstat  = ENC28J60_ReadOp(ENC28J60_READ_BUF_MEM, 0);
   rxstat |= ENC28J60_ReadOp(ENC28J60_READ_BUF_MEM, 0) << 8;
+  State->packet_len = len;
   /* Llimit retrieve length */
   if (len > maxlen - 1) {
       len = maxlen - 1;
@@ -243,22 +407,24 @@ uint16_t ENC28J60_PacketReceive(uint16_t maxlen, uint8_t *packet) {
   if ((rxstat & 0x80) == 0) {
       /* Invalid. */
       len = 0;
+      State->packet_len = 0;
+      STATS_INC(rx_errors);
   } else {
       /* Copy the packet from the receive buffer. */
       ENC28J60_ReadBuffer(len, packet);
+      STATS_INC(rx_frames);
   }
-  /* Move the RX read pointer to the start of the next received packet.
-   * This frees the memory we just read out.
-   */
-  ENC28J60_Write(ERXRDPTL, (NextPacketPtr));
-  ENC28J60_Write(ERXRDPTH, (NextPacketPtr)>>8);
-  /* Decrement the packet counter indicate we are done with this packet. */
-  ENC28J60_WriteOp(ENC28J60_BIT_FIELD_SET, ECON2, ECON2_PKTDEC);
+  SPI_CATEGORY(category);
+  PROF_END(PROF_RECEIVE);
   return len;
 }
 
-void ENC28J60_WriteBuffer(uint16_t len, uint8_t *data) {
-  SSP_CS_IO = 0;
+/* Write data at the write pointer, accounted for the category of the
+ * caller.
+ */
+void ENC28J60_WriteBuffer(uint16_t len, const uint8_t *data) {
+  SPI_ACCOUNT(SPI_Category, 1 + len);
+  SPI_CS_ASSERT();
   /* Issue write command. */
   SSPBUF = ENC28J60_WRITE_BUF_MEM;
   while (!PIR1bits.SSPIF);
@@ -272,24 +438,144 @@ void ENC28J60_WriteBuffer(uint16_t len, uint8_t *data) {
     while (!PIR1bits.SSPIF);
     PIR1bits.SSPIF = 0;
   }
-  SSP_CS_IO = 1;
+  SPI_CS_RELEASE();
 }
 
-void ENC28J60_PacketSend(uint16_t len, uint8_t *packet) {
+/* Allocate len bytes of the buffer memory, which is rounded up to whole
+ * blocks. Returns ENC28J60_NO_MEMORY if there is no continuous range of
+ * free blocks big enough.
+ */
+uint16_t ENC28J60_MemAlloc(uint16_t len) {
+  uint8_t num_blocks = ENC28J60_MEM_ROUND(len) >> ENC28J60_BLOCK_SHIFT;
+  uint16_t mask = (uint16_t)((1UL << num_blocks) - 1);
+  uint8_t i;
+  if (num_blocks == 0 || num_blocks > ENC28J60_MEM_BLOCKS) {
+    return ENC28J60_NO_MEMORY;
+  }
+  for (i = 0; i <= ENC28J60_MEM_BLOCKS - num_blocks; i++) {
+    if ((State->mem_used & mask) == 0) {
+      State->mem_used |= mask;
+      return ENC28J60_MEM_START + ((uint16_t)i << ENC28J60_BLOCK_SHIFT);
+    }
+    mask <<= 1;
+  }
+  return ENC28J60_NO_MEMORY;
+}
+
+/* Free memory allocated with ENC28J60_MemAlloc(len). */
+void ENC28J60_MemFree(uint16_t addr, uint16_t len) {
+  uint8_t num_blocks = ENC28J60_MEM_ROUND(len) >> ENC28J60_BLOCK_SHIFT;
+  uint8_t first = (addr - ENC28J60_MEM_START) >> ENC28J60_BLOCK_SHIFT;
+  State->mem_used &= ~((uint16_t)((1UL << num_blocks) - 1) << first);
+}
+
+/* Address of the transmit buffer used by ENC28J60_PacketBegin(). */
+uint16_t ENC28J60_TxSlot(void) {
+  return State->tx_slot;
+}
+
+void ENC28J60_SetWritePointer(uint16_t addr) {
+  uint8_t category = SPI_CATEGORY_SELECTED();
+  SPI_CATEGORY(SPI_CAT_TX_SETUP);
+  ENC28J60_Write(EWRPTL, addr & 0xff);
+  ENC28J60_Write(EWRPTH, addr >> 8);
+  SPI_CATEGORY(category);
+}
+
+/* Copy len bytes of the buffer memory from src to dst using the DMA
+ * controller, so the data never goes over SPI.
+ *
+ * If the source is in the receive buffer, the DMA controller wraps around
+ * its end the same way as the receiver does.
+ */
+void ENC28J60_DmaCopy(uint16_t src, uint16_t len, uint16_t dst) {
+  uint16_t end = src + len - 1;
+  uint8_t category = SPI_CATEGORY_SELECTED();
+  if (src <= RXSTOP_INIT && end > RXSTOP_INIT) {
+    end -= RXSTOP_INIT - RXSTART_INIT + 1;
+  }
+  SPI_CATEGORY(SPI_CAT_TX_SETUP);
+  ENC28J60_Write(EDMASTL, src & 0xff);
+  ENC28J60_Write(EDMASTH, src >> 8);
+  ENC28J60_Write(EDMANDL, end & 0xff);
+  ENC28J60_Write(EDMANDH, end >> 8);
+  ENC28J60_Write(EDMADSTL, dst & 0xff);
+  ENC28J60_Write(EDMADSTH, dst >> 8);
+  /* Plain copy, no checksum calculation. */
+  ENC28J60_WriteOp(ENC28J60_BIT_FIELD_CLR, ECON1, ECON1_CSUMEN);
+  ENC28J60_WriteOp(ENC28J60_BIT_FIELD_SET, ECON1, ECON1_DMAST);
+  while (ENC28J60_Read(ECON1) & ECON1_DMAST);
+  SPI_CATEGORY(category);
+}
+
+/* Start a new packet in the transmit buffer. The packet is then filled in
+ * with ENC28J60_WriteBuffer() calls and is sent by ENC28J60_PacketCommit().
+ */
+/* Wait for the packet in transmission, if any. */
+static void ENC28J60_TransmitWait(void) {
+  while (ENC28J60_Read(ECON1) & ECON1_TXRTS) {
+    /* Reset the transmit logic problem. See Rev. B4 Silicon Errata point 12. */
+    if ((ENC28J60_Read(EIR) & EIR_TXERIF)) {
+      ENC28J60_WriteOp(ENC28J60_BIT_FIELD_CLR, ECON1, ECON1_TXRTS);
+      STATS_INC(tx_errors);
+    }
+  }
+}
+
+void ENC28J60_PacketBegin(void) {
+  ENC28J60_PacketBeginAt(State->tx_slot);
+}
+
+/* Start writing frame to the slot, see ENC28J60_PacketTransmit(). */
+void ENC28J60_PacketBeginAt(uint16_t slot) {
+  uint8_t category = SPI_CATEGORY_SELECTED();
+  SPI_CATEGORY(SPI_CAT_TX_SETUP);
+  /* Previous packet could still be in transmission from the same buffer. */
+  ENC28J60_TransmitWait();
   /* Set the write pointer to start of transmit buffer area. */
-  ENC28J60_Write(EWRPTL, TXSTART_INIT & 0xff);
-  ENC28J60_Write(EWRPTH, TXSTART_INIT >> 8);
-  /* Set the TXND pointer to correspond to the packet size given. */
-  ENC28J60_Write(ETXNDL, (TXSTART_INIT + len) & 0xff);
-  ENC28J60_Write(ETXNDH, (TXSTART_INIT + len) >> 8);
+  ENC28J60_SetWritePointer(slot);
   /* Write per-packet control byte (0x00 means use macon3 settings). */
   ENC28J60_WriteOp(ENC28J60_WRITE_BUF_MEM, 0, 0x00);
-  /* Copy the packet into the transmit buffer. */
-  ENC28J60_WriteBuffer(len, packet);
+  SPI_CATEGORY(category);
+}
+
+void ENC28J60_PacketCommit(uint16_t len) {
+  ENC28J60_PacketTransmit(State->tx_slot, len);
+}
+
+/* Transmit frame of the given length stored in the memory allocated with
+ * ENC28J60_MemAlloc(ENC28J60_TX_SLOT_SIZE(len)), headed by the control
+ * byte. This way frames could be kept for retransmission and sent again
+ * without going over SPI.
+ */
+void ENC28J60_PacketTransmit(uint16_t slot, uint16_t len) {
+  uint8_t category = SPI_CATEGORY_SELECTED();
+  SPI_CATEGORY(SPI_CAT_TX_SETUP);
+  ENC28J60_TransmitWait();
+  ENC28J60_Write(ETXSTL, slot & 0xff);
+  ENC28J60_Write(ETXSTH, slot >> 8);
+  /* Set the TXND pointer to correspond to the packet size given. */
+  ENC28J60_Write(ETXNDL, (slot + len) & 0xff);
+  ENC28J60_Write(ETXNDH, (slot + len) >> 8);
   /* Send the contents of the transmit buffer onto the network. */
   ENC28J60_WriteOp(ENC28J60_BIT_FIELD_SET, ECON1, ECON1_TXRTS);
+  STATS_INC(tx_frames);
   /* Reset the transmit logic problem. See Rev. B4 Silicon Errata point 12. */
   if ((ENC28J60_Read(EIR) & EIR_TXERIF)) {
     ENC28J60_WriteOp(ENC28J60_BIT_FIELD_CLR, ECON1, ECON1_TXRTS);
+    STATS_INC(tx_errors);
   }
+  SPI_CATEGORY(category);
+}
+
+void ENC28J60_PacketSend(uint16_t len, uint8_t *packet) {
+  uint8_t category = SPI_CATEGORY_SELECTED();
+  PROF_BEGIN(PROF_SEND);
+  ENC28J60_PacketBegin();
+  /* Copy the packet into the transmit buffer. */
+  SPI_CATEGORY(SPI_CAT_TX_PAYLOAD);
+  ENC28J60_WriteBuffer(len, packet);
+  SPI_CATEGORY(category);
+  ENC28J60_PacketCommit(len);
+  PROF_END(PROF_SEND);
 }
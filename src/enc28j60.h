@@ -34,6 +34,8 @@
 
 #include <stdint.h>
 
+#include "system_config.h"
+
 /* ENC28J60 Control Registers
  * Control register definitions are a combination of address,
  * bank number, and Ethernet/MAC/PHY indicator bits.
@@ -275,24 +277,63 @@
 
 
 /* The RXSTART_INIT should be zero. See Rev. B4 Silicon Errata
- * buffer boundaries applied to internal 8K ram
- * the entire available packet buffer space is allocated.
+ * buffer boundaries applied to internal 8K ram.
  */
 /* Start with recbuf at 0. */
 #define RXSTART_INIT     0x0
-/* Receive buffer end. */
-#define RXSTOP_INIT      (0x1FFF - 0x0600 - 1)
-/* start TX buffer at 0x1FFF - 0x0600,
- * pace for one full ethernet frame (~1500 bytes).
+/* Receive buffer end. Must be odd, see ENC28J60_PacketRelease(). */
+#define RXSTOP_INIT      0x0FFF
+
+/* The rest of the buffer memory is handed out by ENC28J60_MemAlloc() in
+ * blocks of 256 bytes. It holds the transmit buffer and anything else the
+ * application wants to keep out of the PIC RAM.
+ */
+#define ENC28J60_MEM_START    (RXSTOP_INIT + 1)
+#define ENC28J60_BLOCK_SHIFT  8
+#define ENC28J60_BLOCK_SIZE   (1 << ENC28J60_BLOCK_SHIFT)
+#define ENC28J60_MEM_BLOCKS   ((0x2000 - ENC28J60_MEM_START) >> \
+                               ENC28J60_BLOCK_SHIFT)
+/* Number of bytes actually taken by allocation of the given size. */
+#define ENC28J60_MEM_ROUND(len)  (((len) + ENC28J60_BLOCK_SIZE - 1) & \
+                                  ~(ENC28J60_BLOCK_SIZE - 1))
+/* Returned by ENC28J60_MemAlloc() on failure, the receive buffer starts
+ * at zero so this is never a valid allocation.
+ */
+#define ENC28J60_NO_MEMORY    0
+/* Size of the memory needed to transmit a frame of the given length:
+ * per-packet control byte, the frame and the transmit status vector.
+ */
+#define ENC28J60_TX_SLOT_SIZE(len)  (1 + (len) + 7)
+
+/* Address of the given packet byte in the transmit buffer, the first byte
+ * of the buffer is per-packet control byte.
  */
-#define TXSTART_INIT     (0x1FFF - 0x0600)
-/* stp TX buffer at end of mem. */
-#define TXSTOP_INIT      0x1FFF
+#define TX_PACKET_ADDR(offset)  (ENC28J60_TxSlot() + 1 + (offset))
 /* Max frame length which the conroller will accept.
  * NOTE: maximum ethernet frame length would be 1518
  */
 #define MAX_FRAMELEN     1500
 //#define MAX_FRAMELEN     600
+/* CLKRDY is not to be trusted during the first millisecond after the
+ * reset command, see Rev. B7 Silicon Errata.
+ */
+#define ENC28J60_RESET_DELAY  1
+
+/* Number of controllers on the SPI bus, each of them on a chip select line
+ * of its own. Every controller has its own state and memory, and all the
+ * functions work with the one selected with ENC28J60_Select().
+ */
+#ifndef ENC28J60_NUM_INTERFACES
+#  define ENC28J60_NUM_INTERFACES  1
+#endif
+
+#if ENC28J60_NUM_INTERFACES > 1
+void ENC28J60_Select(uint8_t iface);
+uint8_t ENC28J60_Selected(void);
+#else
+#  define ENC28J60_Select(iface)  ((void)(iface))
+#  define ENC28J60_Selected()     0
+#endif
 
 void ENC28J60_WriteOp(uint8_t op, uint8_t addr, uint8_t data);
 uint8_t ENC28J60_ReadOp(uint8_t op, uint8_t addr);
@@ -301,11 +342,27 @@ uint8_t ENC28J60_Read(uint8_t addr);
 void ENC28J60_Write(uint8_t addr, uint8_t data);
 void ENC28J60_PhyWrite(uint8_t addr, uint16_t data);
 uint8_t ENC28J60_GetRev(void);
+void ENC28J60_Reset(void);
+uint8_t ENC28J60_IsReady(void);
 void ENC28J60_Init(uint8_t *macaddr);
+void ENC28J60_Configure(uint8_t *macaddr);
 void ENC28J60_ClkOut(uint8_t clk);
 void ENC28J60_ReadBuffer(uint16_t len, uint8_t *data);
+uint16_t ENC28J60_PacketAddr(uint16_t offset);
+uint16_t ENC28J60_PacketLength(void);
+void ENC28J60_PacketRead(uint16_t offset, uint16_t len, uint8_t *data);
+void ENC28J60_PacketRelease(void);
 uint16_t ENC28J60_PacketReceive(uint16_t maxlen, uint8_t *packet);
-void ENC28J60_WriteBuffer(uint16_t len, uint8_t *data);
+void ENC28J60_WriteBuffer(uint16_t len, const uint8_t *data);
+uint16_t ENC28J60_MemAlloc(uint16_t len);
+void ENC28J60_MemFree(uint16_t addr, uint16_t len);
+uint16_t ENC28J60_TxSlot(void);
+void ENC28J60_SetWritePointer(uint16_t addr);
+void ENC28J60_DmaCopy(uint16_t src, uint16_t len, uint16_t dst);
+void ENC28J60_PacketBegin(void);
+void ENC28J60_PacketBeginAt(uint16_t slot);
+void ENC28J60_PacketCommit(uint16_t len);
+void ENC28J60_PacketTransmit(uint16_t slot, uint16_t len);
 void ENC28J60_PacketSend(uint16_t len, uint8_t *packet);
 
 #endif  /* __ENC28J60_H__ */
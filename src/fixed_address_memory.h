@@ -27,4 +27,11 @@
 #define HID_CUSTOM_OUT_DATA_BUFFER_ADDRESS 0x500
 #define HID_CUSTOM_IN_DATA_BUFFER_ADDRESS 0x540
 
+/* Packet buffer of the network application gets bank 1 for itself, so
+ * the linker keeps it out of the way of the other variables and it never
+ * straddles a bank boundary. Banks 4 and up are USB RAM.
+ */
+#define APP_NETWORK_BUFFER_ADDRESS 0x100
+#define APP_NETWORK_BUFFER_MAX_SIZE 0x100
+
 #endif  /* __FIXED_MEMORY_ADDRESS__ */
@@ -0,0 +1,475 @@
+/* Copyright (C) 2015 Sergey Sharybin <sergey.vfx@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include "http.h"
+
+#include <string.h>
+
+enum {
+  HTTP_STATE_METHOD = 0,
+  HTTP_STATE_PATH,
+  HTTP_STATE_QUERY,
+  HTTP_STATE_VERSION,
+  HTTP_STATE_HEADER_NAME,
+  HTTP_STATE_HEADER_VALUE,
+  HTTP_STATE_BODY,
+  HTTP_STATE_DONE,
+  HTTP_STATE_ERROR
+};
+
+/* Headers we are interested in, names are lower case. */
+enum {
+  HTTP_HEADER_CONTENT_LENGTH = 0,
+  HTTP_HEADER_ACCEPT_ENCODING,
+  HTTP_HEADER_IF_NONE_MATCH,
+  HTTP_NUM_HEADERS
+};
+#define HTTP_HEADER_NONE  0xff
+
+static const char *const http_header_names[HTTP_NUM_HEADERS] = {
+  "content-length",
+  "accept-encoding",
+  "if-none-match",
+};
+
+static const char http_gzip[] = "gzip";
+
+/* Names of HTTP_METHOD_GET and up, matched the same way as the headers. */
+static const char *const http_method_names[HTTP_METHOD_POST] = {
+  "GET",
+  "HEAD",
+  "POST"
+};
+#define HTTP_ALL_METHODS  ((uint8_t)((1 << HTTP_METHOD_POST) - 1))
+
+#define HTTP_ALL_HEADERS  ((uint8_t)((1 << HTTP_NUM_HEADERS) - 1))
+
+void HTTP_Init(HTTP_PARSER *parser) {
+  memset(parser, 0, sizeof(HTTP_PARSER));
+  parser->state = HTTP_STATE_METHOD;
+  parser->header = HTTP_ALL_METHODS;
+  parser->path_hash = HTTP_HASH_INIT;
+}
+
+/* Narrow down the methods which match the token so far, header is the
+ * mask of the candidates while the method is parsed.
+ */
+static void http_method_char(HTTP_PARSER *parser, char c) {
+  uint8_t i;
+  for (i = 0; i < HTTP_METHOD_POST; i++) {
+    if ((parser->header & (1 << i)) && http_method_names[i][parser->pos] != c) {
+      parser->header &= ~(1 << i);
+    }
+  }
+  parser->pos++;
+}
+
+static uint8_t http_method_found(HTTP_PARSER *parser) {
+  uint8_t i;
+  for (i = 0; i < HTTP_METHOD_POST; i++) {
+    if ((parser->header & (1 << i)) &&
+        http_method_names[i][parser->pos] == '\0')
+    {
+      return i + 1;
+    }
+  }
+  return HTTP_METHOD_UNKNOWN;
+}
+
+/* Characters of the query and the body are only counted, they stay in the
+ * receive buffer. Together with the '&' between them they are limited to
+ * HTTP_MAX_QUERY.
+ */
+static uint8_t http_query_room(HTTP_PARSER *parser) {
+  uint8_t used = parser->query_len + parser->body_len;
+  if (parser->query_len != 0 && parser->state == HTTP_STATE_BODY) {
+    used++;
+  }
+  if (used >= HTTP_MAX_QUERY) {
+    parser->flags |= HTTP_FLAG_QUERY_TOO_LONG;
+    return 0;
+  }
+  return 1;
+}
+
+/* Narrow down the headers which match the name so far. */
+static void http_header_name(HTTP_PARSER *parser, char c) {
+  uint8_t i;
+  if (c >= 'A' && c <= 'Z') {
+    c += 'a' - 'A';
+  }
+  for (i = 0; i < HTTP_NUM_HEADERS; i++) {
+    if ((parser->header & (1 << i)) &&
+        (c == '\0' || http_header_names[i][parser->pos] != c))
+    {
+      parser->header &= ~(1 << i);
+    }
+  }
+  if (parser->pos != 0xff) {
+    parser->pos++;
+  }
+}
+
+/* Pick the header which matches the whole name. */
+static uint8_t http_header_found(HTTP_PARSER *parser) {
+  uint8_t i;
+  for (i = 0; i < HTTP_NUM_HEADERS; i++) {
+    if ((parser->header & (1 << i)) &&
+        http_header_names[i][parser->pos] == '\0')
+    {
+      return i;
+    }
+  }
+  return HTTP_HEADER_NONE;
+}
+
+static int8_t http_hex_digit(char c) {
+  if (c >= '0' && c <= '9') {
+    return c - '0';
+  }
+  if (c >= 'a' && c <= 'f') {
+    return c - 'a' + 10;
+  }
+  if (c >= 'A' && c <= 'F') {
+    return c - 'A' + 10;
+  }
+  return -1;
+}
+
+/* Tags we send are exactly this many hex digits. */
+#define HTTP_TAG_DIGITS  8
+/* pos of If-None-Match once the first tag is over. */
+#define HTTP_TAG_DONE    0xff
+
+/* End of the first tag of If-None-Match, anything but a tag of exactly
+ * HTTP_TAG_DIGITS hex digits is not ours.
+ */
+static void http_tag_done(HTTP_PARSER *parser) {
+  if (parser->flags & HTTP_FLAG_IF_NONE_MATCH) {
+    return;
+  }
+  if (parser->pos == HTTP_TAG_DIGITS) {
+    parser->flags |= HTTP_FLAG_IF_NONE_MATCH;
+  } else {
+    parser->if_none_match = 0;
+  }
+  parser->pos = HTTP_TAG_DONE;
+}
+
+static void http_header_value(HTTP_PARSER *parser, char c) {
+  int8_t digit;
+  switch (parser->header) {
+    case HTTP_HEADER_CONTENT_LENGTH:
+      if (c >= '0' && c <= '9') {
+        if (parser->content_length > (0xffff - (c - '0')) / 10) {
+          parser->state = HTTP_STATE_ERROR;
+          break;
+        }
+        parser->content_length = parser->content_length * 10 + (c - '0');
+      }
+      break;
+    case HTTP_HEADER_ACCEPT_ENCODING:
+      /* Look for gzip in the list, pos is the number of matched characters.
+       * Quality values are ignored, nobody sends gzip;q=0 in practice.
+       */
+      if (c == http_gzip[parser->pos]) {
+        if (++parser->pos == sizeof(http_gzip) - 1) {
+          parser->flags |= HTTP_FLAG_ACCEPT_GZIP;
+          parser->pos = 0;
+        }
+      } else {
+        parser->pos = (c == http_gzip[0]) ? 1 : 0;
+      }
+      break;
+    case HTTP_HEADER_IF_NONE_MATCH:
+      /* Only the first tag is kept, pos counts its digits.
+       * Quotes, weak prefix and spaces around it are skipped.
+       */
+      if (parser->pos == HTTP_TAG_DONE ||
+          (parser->flags & HTTP_FLAG_IF_NONE_MATCH))
+      {
+        break;
+      }
+      digit = http_hex_digit(c);
+      if (c == ',' || (c == '"' && parser->pos != 0)) {
+        http_tag_done(parser);
+      } else if (digit >= 0 && parser->pos < HTTP_TAG_DIGITS) {
+        parser->if_none_match = (parser->if_none_match << 4) | (uint8_t)digit;
+        parser->pos++;
+      } else if (c != '"' && c != 'W' && c != '/' && c != ' ' && c != '\t') {
+        /* Longer tag, or not a tag at all. */
+        parser->if_none_match = 0;
+        parser->pos = HTTP_TAG_DONE;
+      }
+      break;
+  }
+}
+
+/* End of the header block. */
+static void http_headers_done(HTTP_PARSER *parser) {
+  if (parser->method == HTTP_METHOD_POST && parser->content_length != 0) {
+    parser->state = HTTP_STATE_BODY;
+  } else {
+    parser->state = HTTP_STATE_DONE;
+  }
+}
+
+/* Start of the next segment of the request. Query and body are read from
+ * the segment which completes the request, whatever of them came before
+ * is not in the receive buffer any more.
+ */
+void HTTP_NextSegment(HTTP_PARSER *parser) {
+  if (parser->query_len != 0 || parser->body_len != 0) {
+    parser->flags |= HTTP_FLAG_QUERY_LOST;
+  }
+}
+
+/* Feed len bytes of the request to the parser, pos is their offset in the
+ * received frame. Returns HTTP_PARSE_MORE until the whole request is
+ * parsed, and HTTP_PARSE_OVER for anything which comes after it.
+ */
+uint8_t HTTP_Parse(HTTP_PARSER *parser,
+                   const uint8_t *data,
+                   uint16_t len,
+                   uint16_t pos) {
+  char c;
+  if (parser->state >= HTTP_STATE_DONE) {
+    return HTTP_PARSE_OVER;
+  }
+  for (; len != 0 && parser->state < HTTP_STATE_DONE; len--, pos++) {
+    c = *data++;
+    switch (parser->state) {
+      case HTTP_STATE_METHOD:
+        if (c == ' ') {
+          parser->method = http_method_found(parser);
+          parser->state = HTTP_STATE_PATH;
+        } else if (parser->pos < 4) {
+          http_method_char(parser, c);
+        } else {
+          parser->state = HTTP_STATE_ERROR;
+        }
+        break;
+      case HTTP_STATE_PATH:
+        if (c == ' ' || c == '?') {
+          parser->state = (c == ' ') ? HTTP_STATE_VERSION : HTTP_STATE_QUERY;
+        } else if (c == '\r' || c == '\n') {
+          parser->state = HTTP_STATE_ERROR;
+        } else if (parser->path_len == HTTP_MAX_PATH) {
+          parser->flags |= HTTP_FLAG_PATH_TOO_LONG;
+        } else {
+          parser->path_len++;
+          parser->path_hash = HTTP_HASH_STEP(parser->path_hash, c);
+        }
+        break;
+      case HTTP_STATE_QUERY:
+        if (c == ' ') {
+          parser->state = HTTP_STATE_VERSION;
+        } else if (c == '\r' || c == '\n') {
+          parser->state = HTTP_STATE_ERROR;
+        } else if (http_query_room(parser)) {
+          if (parser->query_len++ == 0) {
+            parser->query_pos = pos;
+          }
+        }
+        break;
+      case HTTP_STATE_VERSION:
+        if (c == '\n') {
+          parser->header = HTTP_ALL_HEADERS;
+          parser->pos = 0;
+          parser->state = HTTP_STATE_HEADER_NAME;
+        }
+        break;
+      case HTTP_STATE_HEADER_NAME:
+        if (c == '\r') {
+          break;
+        }
+        if (c == '\n') {
+          if (parser->pos == 0) {
+            /* Empty line. */
+            http_headers_done(parser);
+          } else {
+            /* Broken header, ignore it. */
+            parser->header = HTTP_ALL_HEADERS;
+            parser->pos = 0;
+          }
+        } else if (c == ':') {
+          parser->header = http_header_found(parser);
+          parser->pos = 0;
+          parser->state = HTTP_STATE_HEADER_VALUE;
+        } else {
+          http_header_name(parser, c);
+        }
+        break;
+      case HTTP_STATE_HEADER_VALUE:
+        if (c == '\n') {
+          if (parser->header == HTTP_HEADER_IF_NONE_MATCH) {
+            http_tag_done(parser);
+          }
+          parser->header = HTTP_ALL_HEADERS;
+          parser->pos = 0;
+          parser->state = HTTP_STATE_HEADER_NAME;
+        } else if (c != '\r') {
+          http_header_value(parser, c);
+        }
+        break;
+      case HTTP_STATE_BODY:
+        if (http_query_room(parser)) {
+          if (parser->body_len++ == 0) {
+            parser->body_pos = pos;
+          }
+        }
+        if (--parser->content_length == 0) {
+          parser->state = HTTP_STATE_DONE;
+        }
+        break;
+    }
+  }
+  if (parser->state == HTTP_STATE_DONE) {
+    return HTTP_PARSE_DONE;
+  }
+  if (parser->state == HTTP_STATE_ERROR) {
+    return HTTP_PARSE_ERROR;
+  }
+  return HTTP_PARSE_MORE;
+}
+
+uint8_t HTTP_ParseQuery(const char *query,
+                        uint8_t len,
+                        HTTP_PARAM *params,
+                        uint8_t max) {
+  HTTP_PARAM *param = params;
+  uint8_t count = 0;
+  uint16_t i;
+  if (max == 0) {
+    return 0;
+  }
+  param->key = query;
+  param->key_len = 0;
+  param->value = 0;
+  param->value_len = 0;
+  for (i = 0; i <= len; i++) {
+    if (i == len || query[i] == '&') {
+      /* Skip empty parameters, such as in "a=1&&b=2". */
+      if (param->key_len != 0 || param->value != 0) {
+        if (++count == max) {
+          break;
+        }
+        param++;
+      }
+      param->key = &query[i + 1];
+      param->key_len = 0;
+      param->value = 0;
+      param->value_len = 0;
+    } else if (param->value != 0) {
+      param->value_len++;
+    } else if (query[i] == '=') {
+      param->value = &query[i + 1];
+    } else {
+      param->key_len++;
+    }
+  }
+  return count;
+}
+
+const HTTP_PARAM *HTTP_FindParam(const HTTP_PARAM *params,
+                                 uint8_t count,
+                                 const char *key) {
+  uint8_t len = strlen(key);
+  for (; count != 0; count--, params++) {
+    if (params->key_len == len && memcmp(params->key, key, len) == 0) {
+      return params;
+    }
+  }
+  return 0;
+}
+
+uint8_t HTTP_ParamDecode(const HTTP_PARAM *param, char *str, uint8_t size) {
+  const char *value = param->value;
+  uint8_t i, len = 0;
+  int8_t high, low;
+  for (i = 0; i < param->value_len && len + 1 < size; i++) {
+    if (value[i] == '+') {
+      str[len++] = ' ';
+      continue;
+    }
+    if (value[i] == '%' && i + 2 < param->value_len) {
+      high = http_hex_digit(value[i + 1]);
+      low = http_hex_digit(value[i + 2]);
+      if (high >= 0 && low >= 0) {
+        str[len++] = (char)((high << 4) | low);
+        i += 2;
+        continue;
+      }
+    }
+    str[len++] = value[i];
+  }
+  if (size != 0) {
+    str[len] = '\0';
+  }
+  return len;
+}
+
+uint8_t HTTP_ParamUint(const HTTP_PARAM *param, uint16_t *value) {
+  uint32_t result = 0;
+  uint8_t i;
+  if (param->value_len == 0) {
+    return 0;
+  }
+  for (i = 0; i < param->value_len; i++) {
+    if (param->value[i] < '0' || param->value[i] > '9') {
+      return 0;
+    }
+    result = result * 10 + (param->value[i] - '0');
+    if (result > 0xffff) {
+      return 0;
+    }
+  }
+  *value = (uint16_t)result;
+  return 1;
+}
+
+const HTTP_ROUTE *HTTP_FindRoute(const HTTP_ROUTE *routes,
+                                 uint8_t bits,
+                                 uint16_t mult,
+                                 const HTTP_PARSER *parser) {
+  const HTTP_ROUTE *route;
+  const char *path;
+  uint16_t hash = HTTP_HASH_INIT;
+  uint8_t len = 0;
+  if (parser->flags & HTTP_FLAG_PATH_TOO_LONG) {
+    return 0;
+  }
+  route = &routes[(uint16_t)(parser->path_hash * mult) >> (16 - bits)];
+  if (route->path == 0) {
+    return 0;
+  }
+  /* Hash is perfect only for the known paths, anything else could land
+   * on any entry. The path itself is not kept, so it is the hash and the
+   * length of the path which have to match.
+   */
+  for (path = route->path; *path != '\0'; path++, len++) {
+    hash = HTTP_HASH_STEP(hash, *path);
+  }
+  if (hash != parser->path_hash || len != parser->path_len) {
+    return 0;
+  }
+  return route;
+}
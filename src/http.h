@@ -0,0 +1,166 @@
+/* Copyright (C) 2015 Sergey Sharybin <sergey.vfx@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#ifndef __HTTP_H__
+#define __HTTP_H__
+
+#include <stdint.h>
+
+/* Incremental HTTP/1.x request parser.
+ *
+ * Request is fed in pieces of any size as segments arrive, the parser only
+ * keeps method, hash of the path, where the query is and values of the
+ * headers we care about, so the request itself stays in the ENC28J60
+ * receive buffer. Query is read from there once the request is parsed.
+ *
+ * Body of POST requests is appended to the query, so forms are handled the
+ * same way as GET parameters. Both are to arrive in the segment which
+ * completes the request.
+ *
+ * Hash of the path is computed while it arrives, so requests are routed
+ * with a single lookup in the table generated by tools/gen_routes.py.
+ */
+
+#ifndef HTTP_MAX_PATH
+#  define HTTP_MAX_PATH   23
+#endif
+#ifndef HTTP_MAX_QUERY
+#  define HTTP_MAX_QUERY  39
+#endif
+/* Query parameters passed to the route handlers. */
+#ifndef HTTP_MAX_PARAMS
+#  define HTTP_MAX_PARAMS  6
+#endif
+
+#define HTTP_METHOD_UNKNOWN  0
+#define HTTP_METHOD_GET      1
+#define HTTP_METHOD_HEAD     2
+#define HTTP_METHOD_POST     3
+
+#define HTTP_METHOD_MASK(method)  ((uint8_t)(1 << (method)))
+
+/* Result of HTTP_Parse(). */
+#define HTTP_PARSE_MORE   0
+#define HTTP_PARSE_DONE   1
+#define HTTP_PARSE_ERROR  2
+#define HTTP_PARSE_OVER   3  /* Data after the parsed request. */
+
+/* Flags of the parsed request. */
+#define HTTP_FLAG_PATH_TOO_LONG   0x01
+#define HTTP_FLAG_QUERY_TOO_LONG  0x02
+#define HTTP_FLAG_ACCEPT_GZIP     0x04  /* Accept-Encoding lists gzip. */
+#define HTTP_FLAG_IF_NONE_MATCH   0x08  /* if_none_match is set. */
+/* Query or body started in a segment before the last one. */
+#define HTTP_FLAG_QUERY_LOST      0x10
+
+/* Hash of the path, must match path_hash() from tools/gen_routes.py. */
+#define HTTP_HASH_INIT  5381
+#define HTTP_HASH_STEP(hash, c) \
+  ((uint16_t)(((hash) << 5) + (hash) + (uint8_t)(c)))
+
+typedef struct {
+  uint8_t state;
+  uint8_t method;
+  uint8_t flags;
+  /* Headers which still match the name being parsed, or the header whose
+   * value is being parsed.
+   */
+  uint8_t header;
+  uint8_t pos;
+  uint8_t path_len;
+  uint16_t path_hash;
+  /* Query and body of POST in the received frame, as given to
+   * HTTP_Parse(). Lengths stop at HTTP_MAX_QUERY.
+   */
+  uint16_t query_pos;
+  uint8_t query_len;
+  uint16_t body_pos;
+  uint8_t body_len;
+  uint16_t content_length;
+  /* First tag of If-None-Match, tags we send are 32 bit hex numbers. */
+  uint32_t if_none_match;
+} HTTP_PARSER;
+
+/* Slice of the query string, neither key nor value are NUL-terminated
+ * or decoded.
+ */
+typedef struct {
+  const char *key;
+  const char *value;
+  uint8_t key_len;
+  uint8_t value_len;
+} HTTP_PARAM;
+
+typedef void (*HTTP_HANDLER)(int8_t conn,
+                             uint8_t *buf,
+                             HTTP_PARSER *parser,
+                             const HTTP_PARAM *params,
+                             uint8_t num_params);
+
+/* Entry of the route table, methods is a mask of HTTP_METHOD_MASK().
+ * Unused entries have path set to 0.
+ */
+typedef struct {
+  const char *path;
+  uint8_t methods;
+  HTTP_HANDLER handler;
+} HTTP_ROUTE;
+
+void HTTP_Init(HTTP_PARSER *parser);
+void HTTP_NextSegment(HTTP_PARSER *parser);
+uint8_t HTTP_Parse(HTTP_PARSER *parser,
+                   const uint8_t *data,
+                   uint16_t len,
+                   uint16_t pos);
+
+/* Split query of len bytes into at most max parameters in a single pass.
+ * Returns number of the parameters stored, the rest of them are ignored.
+ */
+uint8_t HTTP_ParseQuery(const char *query,
+                        uint8_t len,
+                        HTTP_PARAM *params,
+                        uint8_t max);
+
+/* Find parameter with the given key, returns 0 if there is no such one. */
+const HTTP_PARAM *HTTP_FindParam(const HTTP_PARAM *params,
+                                 uint8_t count,
+                                 const char *key);
+
+/* Percent-decode value of the parameter into NUL-terminated string of at
+ * most size - 1 characters. Returns length of the decoded value.
+ */
+uint8_t HTTP_ParamDecode(const HTTP_PARAM *param, char *str, uint8_t size);
+
+/* Convert value of the parameter to a number.
+ * Returns 0 if the value is empty, not a decimal number or too big.
+ */
+uint8_t HTTP_ParamUint(const HTTP_PARAM *param, uint16_t *value);
+
+/* Find route of the parsed request in the table of (1 << bits) entries
+ * indexed by the perfect hash with the given multiplier.
+ * Returns 0 if there is no such path, methods are to be checked by caller.
+ */
+const HTTP_ROUTE *HTTP_FindRoute(const HTTP_ROUTE *routes,
+                                 uint8_t bits,
+                                 uint16_t mult,
+                                 const HTTP_PARSER *parser);
+
+#endif  /* __HTTP_H__ */
@@ -31,16 +31,123 @@
 
 #include "net.h"
 #include "enc28j60.h"
+#include "prof.h"
+#include "spi.h"
+#include "stats.h"
+#include "timer.h"
 
-static uint8_t wwwport = 80;
-static uint8_t macaddr[6];
-static uint8_t ipaddr[4];
+#include <string.h>
+
+#ifdef NET_STATIC_ADDRESS
+#  if ENC28J60_NUM_INTERFACES > 1
+#    error "Static addresses are only there for a single interface"
+#  endif
+/* Addresses are constants from system_config.h. */
+#  define IS_MY_IP(p)  ((p)[0] == NET_IP_ADDR0 && (p)[1] == NET_IP_ADDR1 && \
+                        (p)[2] == NET_IP_ADDR2 && (p)[3] == NET_IP_ADDR3)
+#  define PUT_MY_IP(p) \
+  do { \
+    (p)[0] = NET_IP_ADDR0; (p)[1] = NET_IP_ADDR1; \
+    (p)[2] = NET_IP_ADDR2; (p)[3] = NET_IP_ADDR3; \
+  } while (0)
+#  define PUT_MY_MAC(p) \
+  do { \
+    (p)[0] = NET_MAC_ADDR0; (p)[1] = NET_MAC_ADDR1; \
+    (p)[2] = NET_MAC_ADDR2; (p)[3] = NET_MAC_ADDR3; \
+    (p)[4] = NET_MAC_ADDR4; (p)[5] = NET_MAC_ADDR5; \
+  } while (0)
+#else
+/* Addresses of every interface, the selected one is used. */
+static uint8_t macaddr[ENC28J60_NUM_INTERFACES][6];
+static uint8_t ipaddr[ENC28J60_NUM_INTERFACES][4];
+#  define IS_MY_IP(p)    (memcmp((p), ipaddr[ENC28J60_Selected()], 4) == 0)
+#  define PUT_MY_IP(p)   memcpy((p), ipaddr[ENC28J60_Selected()], 4)
+#  define PUT_MY_MAC(p)  memcpy((p), macaddr[ENC28J60_Selected()], 6)
+#endif
+/* State which refers to a controller remembers its interface. Packets are
+ * handled on the selected interface and everything sent later selects the
+ * interface of the connection or stream it belongs to.
+ */
+#if ENC28J60_NUM_INTERFACES > 1
+#  define IS_MY_IFACE(entry)  ((entry)->iface == ENC28J60_Selected())
+#else
+#  define IS_MY_IFACE(entry)  1
+#endif
+#if NET_FEATURE_UDP
+/* Addresses of the peers we talk to. */
+typedef struct {
+  uint8_t ip[4];
+  uint8_t mac[6];
+  uint8_t iface;
+} NET_ARP_ENTRY;
+static NET_ARP_ENTRY arp_cache[NET_ARP_CACHE_ENTRIES];
+static uint8_t arp_cache_next = 0;
+/* Datagram being written to the transmit buffer, see NET_udp_begin(). */
+static NET_UDP_STREAM udp_stream;
+#endif
+/* Handlers of incoming packets, see NET_dispatch(). */
+typedef struct {
+  uint8_t proto;
+  uint16_t port;
+  NET_HANDLER handler;
+} NET_HANDLER_ENTRY;
+static NET_HANDLER_ENTRY handlers[NET_MAX_HANDLERS];
+static uint8_t num_handlers = 0;
+#if NET_FEATURE_TCP_SERVER
+/* Services accepting TCP connections, see NET_tcp_listen(). */
+typedef struct {
+  uint16_t port;
+  uint8_t max_connections;
+  NET_TCP_ACCEPT accept;
+  NET_TCP_RECEIVE receive;
+} NET_TCP_LISTENER;
+static NET_TCP_LISTENER tcp_listeners[NET_TCP_MAX_LISTENERS];
+static uint8_t num_tcp_listeners = 0;
+static void tcp_input(NET_TCP_LISTENER *listener, uint8_t *buf);
+#endif
+#if NET_FEATURE_TCP
 static int16_t info_hdr_len = 0;
 static int16_t info_data_len = 0;
 static uint8_t seqnum = 0xa; /* Initial tcp sequence number. */
+#endif
 
 static uint16_t ip_identifier = 1;
 
+#if NET_FEATURE_TCP_SERVER
+enum {
+  TCP_STATE_CLOSED       = 0,
+  TCP_STATE_SYN_RECEIVED = 1,
+  TCP_STATE_ESTABLISHED  = 2
+};
+
+typedef struct {
+  uint8_t state;
+  uint8_t iface;
+  /* Next sequence number we are to send, ISN + 1 after the SYN. */
+  uint32_t snd_nxt;
+  /* Oldest sequence number not acknowledged by the other side yet. */
+  uint32_t snd_una;
+  /* Next sequence number we expect to receive. */
+  uint32_t rcv_nxt;
+  /* Time in seconds of the last activity. */
+  uint16_t timestamp;
+  /* Partial sums of the header fields which never change during the
+   * connection lifetime: the IP header without length and identification
+   * and the TCP pseudo header, ports, header length and window.
+   */
+  uint16_t ip_sum;
+  uint16_t tcp_sum;
+  /* Eth/IP/TCP header of the segments we send with pre-filled addresses
+   * and ports. Segments only need to patch length, sequence numbers, flags
+   * and checksums.
+   */
+  uint8_t header[TCP_OPTIONS_P];
+} NET_TCP_CONNECTION;
+
+static NET_TCP_CONNECTION tcp_connections[NET_TCP_MAX_CONNECTIONS];
+static uint32_t syncookie_secret = 0;
+#endif
+
 /* The Ip checksum is calculated over the ip header only starting
  * with the header length field and a total length of 20 bytes
  * unitl ip.dst
@@ -73,6 +180,56 @@ enum {
   CHECKSUM_TYPE_TCP = 2,
 };
 
+/* One's complement sum of 16 bit words without the final complement,
+ * so checksums can be built incrementally from partial sums.
+ */
+static uint16_t checksum_add(uint16_t start,
+                             const uint8_t *buf,
+                             uint16_t len) {
+  uint32_t sum = start;
+  PROF_BEGIN(PROF_CHECKSUM);
+  /* Build the sum of 16bit words. */
+  while (len > 1) {
+    sum += 0xffff & (*buf << 8 | *(buf + 1));
+    buf += 2;
+    len -= 2;
+  }
+  /* If there is a byte left then add it (padded with zero). */
+  if (len) {
+    sum += (0xff & *buf) << 8;
+  }
+  /* Now calculate the sum over the bytes in the sum
+   * until the result is only 16bit long.
+   */
+  while (sum >> 16) {
+    sum = (sum & 0xffff) + (sum >> 16);
+  }
+  PROF_END(PROF_CHECKSUM);
+  return (uint16_t)sum;
+}
+
+#if NET_FEATURE_TCP_SERVER || NET_FEATURE_UDP || NET_FEATURE_ICMP
+static uint16_t checksum_add_u16(uint16_t sum, uint16_t value) {
+  sum += value;
+  if (sum < value) {
+    /* End around carry. */
+    sum++;
+  }
+  return sum;
+}
+#endif
+
+#if NET_FEATURE_TCP_SERVER || NET_FEATURE_UDP
+/* Partial sum of a segment placed at the given offset of the payload. */
+static uint16_t page_segment_sum(uint16_t sum, uint16_t pos) {
+  if (pos & 1) {
+    /* Words of data starting at odd offset are byte swapped. */
+    return (sum << 8) | (sum >> 8);
+  }
+  return sum;
+}
+#endif
+
 uint16_t checksum(uint8_t *buf, uint16_t len, uint8_t type) {
   /* type 0 = ip
    *      1 = udp
@@ -95,43 +252,37 @@ uint16_t checksum(uint8_t *buf, uint16_t len, uint8_t type) {
      */
     sum += len - 8;  /* = real tcp len. */
   }
-  /* Build the sum of 16bit words. */
-  while (len > 1) {
-    sum += 0xffff & (*buf << 8 | *(buf + 1));
-    buf += 2;
-    len -= 2;
-  }
-  /* If there is a byte left then add it (padded with zero). */
-  if (len) {
-    sum += (0xff & *buf) << 8;
-  }
-  /* Now calculate the sum over the bytes in the sum
-   * until the result is only 16bit long.
-   */
-  while (sum >> 16) {
-    sum = (sum & 0xffff) + (sum >> 16);
-  }
   /* Build 1's complement. */
-  return (uint16_t)sum ^ 0xffff;
+  return checksum_add((uint16_t)sum, buf, len) ^ 0xffff;
+}
+
+#if NET_FEATURE_TCP
+static uint32_t get_u32(uint8_t *buf) {
+  return ((uint32_t)buf[0] << 24) | ((uint32_t)buf[1] << 16) |
+         ((uint16_t)buf[2] << 8) | buf[3];
 }
 
+static void put_u32(uint8_t *buf, uint32_t value) {
+  buf[0] = value >> 24;
+  buf[1] = value >> 16;
+  buf[2] = value >> 8;
+  buf[3] = value & 0xff;
+}
+#endif
+
 /* You must call this function once before you use any of the other functions. */
-void NET_init(uint8_t *mac_addr, uint8_t *ip_addr, uint8_t port) {
-  uint8_t i = 0;
-  wwwport = port;
-  while (i < 4) {
-    ipaddr[i] = ip_addr[i];
-    i++;
-  }
-  i = 0;
-  while (i < 6) {
-    macaddr[i] = mac_addr[i];
-    i++;
-  }
+/* Addresses are ignored with NET_STATIC_ADDRESS. */
+/* Addresses are for the interface selected with ENC28J60_Select(), so this
+ * is to be called for every interface.
+ */
+void NET_init(uint8_t *mac_addr, uint8_t *ip_addr) {
+#ifndef NET_STATIC_ADDRESS
+  memcpy(ipaddr[ENC28J60_Selected()], ip_addr, 4);
+  memcpy(macaddr[ENC28J60_Selected()], mac_addr, 6);
+#endif
 }
 
 uint8_t NET_eth_type_is_arp_and_my_ip(uint8_t *buf, uint16_t len) {
-  uint8_t i = 0;
   if (len < 41) {
     return 0;
   }
@@ -140,17 +291,10 @@ uint8_t NET_eth_type_is_arp_and_my_ip(uint8_t *buf, uint16_t len) {
   {
     return 0;
   }
-  while (i < 4) {
-    if (buf[ETH_ARP_DST_IP_P+i] != ipaddr[i]) {
-      return 0;
-    }
-    i++;
-  }
-  return 1;
+  return IS_MY_IP(&buf[ETH_ARP_DST_IP_P]);
 }
 
 uint8_t NET_eth_type_is_ip_and_my_ip(uint8_t *buf, uint16_t len) {
-  uint8_t i = 0;
   /* eth+ip+udp header is 42. */
   if (len < 42) {
     return 0;
@@ -164,38 +308,27 @@ uint8_t NET_eth_type_is_ip_and_my_ip(uint8_t *buf, uint16_t len) {
     /* Must be IP V4 and 20 byte header. */
     return 0;
   }
-  while (i < 4) {
-    if (buf[IP_DST_P + i] != ipaddr[i]) {
-      return 0;
-    }
-    i++;
-  }
-  return 1;
+  return IS_MY_IP(&buf[IP_DST_P]);
 }
 
 /* Make a return eth header from a received eth packet. */
 static void make_eth(uint8_t *buf) {
-  uint8_t i = 0;
   /* Copy the destination mac from the source and fill my mac into src. */
-  while (i < 6) {
-    buf[ETH_DST_MAC + i] = buf[ETH_SRC_MAC +i];
-    buf[ETH_SRC_MAC + i] = macaddr[i];
-    i++;
-  }
+  memcpy(&buf[ETH_DST_MAC], &buf[ETH_SRC_MAC], 6);
+  PUT_MY_MAC(&buf[ETH_SRC_MAC]);
 }
 
+#if NET_FEATURE_UDP || NET_FEATURE_TCP_CLIENT
 /* Make a new eth header for IP packet. */
 static void make_eth_ip_new(uint8_t *buf, uint8_t* dst_mac) {
-  uint8_t i = 0;
-  /* Copy the destination mac from the source and fill my mac into src. */
-  while (i < 6) {
-    buf[ETH_DST_MAC +i] = dst_mac[i];
-    buf[ETH_SRC_MAC +i] = macaddr[i];
-    i++;
-  }
+  memcpy(&buf[ETH_DST_MAC], dst_mac, 6);
+  PUT_MY_MAC(&buf[ETH_SRC_MAC]);
   buf[ETH_TYPE_H_P] = ETHTYPE_IP_H_V;
   buf[ETH_TYPE_L_P] = ETHTYPE_IP_L_V;
 }
+#endif
+
+#if NET_FEATURE_ICMP || NET_FEATURE_TCP
 
 static void fill_ip_hdr_checksum(uint8_t *buf) {
   uint16_t ck;
@@ -211,11 +344,11 @@ static void fill_ip_hdr_checksum(uint8_t *buf) {
   buf[IP_CHECKSUM_P + 1] = ck & 0xff;
 }
 
+#if NET_FEATURE_TCP_CLIENT
 /* ** Make a new ip header for tcp packet. ** */
 
 /* Make a return ip header from a received ip packet. */
 static void make_ip_tcp_new(uint8_t *buf, uint16_t len, uint8_t *dst_ip) {
-  uint8_t i = 0;
   /* Set ipv4 and header length. */
   buf[IP_P] = IP_V4_V | IP_HEADER_LENGTH_V;
   /* Set TOS to default 0x00. */
@@ -235,24 +368,21 @@ static void make_ip_tcp_new(uint8_t *buf, uint16_t len, uint8_t *dst_ip) {
   /* Set ip packettype to tcp/udp/icmp. */
   buf[IP_PROTO_P] = IP_PROTO_TCP_V;
   /* Set source and destination ip address. */
-  while (i < 4) {
-    buf[IP_DST_P + i] = dst_ip[i];
-    buf[IP_SRC_P + i] = ipaddr[i];
-    i++;
-  }
+  memcpy(&buf[IP_DST_P], dst_ip, 4);
+  PUT_MY_IP(&buf[IP_SRC_P]);
   fill_ip_hdr_checksum(buf);
 }
+#endif
 
 /* Make a return ip header from a received ip packet. */
 static void make_ip(uint8_t *buf) {
-  uint8_t i = 0;
-  while (i < 4) {
-    buf[IP_DST_P + i] = buf[IP_SRC_P + i];
-    buf[IP_SRC_P + i] = ipaddr[i];
-    i++;
-  }
+  memcpy(&buf[IP_DST_P], &buf[IP_SRC_P], 4);
+  PUT_MY_IP(&buf[IP_SRC_P]);
   fill_ip_hdr_checksum(buf);
 }
+#endif
+
+#if NET_FEATURE_TCP
 
 /* Make a return tcp header from a received tcp packet.
  * rel_ack_num is how much we must step the seq number received from the
@@ -264,8 +394,9 @@ static void make_ip(uint8_t *buf) {
  * After calling this function you can fill in the first data byte at
  * TCP_OPTIONS_P + 4.
  *
- * If cp_seq=0 then an initial sequence number is used (should be use in synack)
- * otherwise it is copied from the packet we received
+ * If cp_seq=0 then the sequence number is cleared and the caller is to put
+ * an initial sequence number (should be use in synack), otherwise it is copied
+ * from the packet we received.
  */
 static void make_tcphead(uint8_t *buf,
                          uint16_t rel_ack_num,
@@ -273,13 +404,13 @@ static void make_tcphead(uint8_t *buf,
                          uint8_t cp_seq) {
   uint8_t i = 0;
   uint8_t tseq;
+  /* Swap the ports. */
   while (i < 2) {
+    tseq = buf[TCP_DST_PORT_H_P + i];
     buf[TCP_DST_PORT_H_P + i] = buf[TCP_SRC_PORT_H_P + i];
-    buf[TCP_SRC_PORT_H_P + i] = 0;  /* Clear source port. */
+    buf[TCP_SRC_PORT_H_P + i] = tseq;
     i++;
   }
-  /* Set source port: */
-  buf[TCP_SRC_PORT_L_P] = wwwport;
   i = 4;
   /* sequence numbers, add the rel ack num to SEQACK. */
   while (i > 0) {
@@ -295,20 +426,6 @@ static void make_tcphead(uint8_t *buf,
     rel_ack_num = rel_ack_num >> 8;
     i--;
   }
-  if (cp_seq == 0) {
-    /* Put inital seq number. */
-    buf[TCP_SEQ_H_P + 0] = 0;
-    buf[TCP_SEQ_H_P + 1] = 0;
-    /* We step only the second byte, this allows us to send packts
-     * with 255 bytes or 512 (if we step the initial seqnum by 2).
-     */
-    buf[TCP_SEQ_H_P + 2] = seqnum;
-    buf[TCP_SEQ_H_P + 3] = 0;
-    /* Step the inititial seq num by something we will not use
-     * during this tcp session.
-     */
-    seqnum += 2;
-  }
   /* Zero the checksum. */
   buf[TCP_CHECKSUM_H_P] = 0;
   buf[TCP_CHECKSUM_L_P] = 0;
@@ -330,80 +447,1197 @@ static void make_tcphead(uint8_t *buf,
     buf[TCP_HEADER_LEN_P] = 0x50;
   }
 }
+#endif
 
 void NET_make_arp_answer_from_request(uint8_t *buf) {
-  uint8_t i = 0;
   make_eth(buf);
   buf[ETH_ARP_OPCODE_H_P] = ETH_ARP_OPCODE_REPLY_H_V;
   buf[ETH_ARP_OPCODE_L_P] = ETH_ARP_OPCODE_REPLY_L_V;
   /* Fill the mac addresses. */
-  while (i < 6) {
-    buf[ETH_ARP_DST_MAC_P + i] = buf[ETH_ARP_SRC_MAC_P + i];
-    buf[ETH_ARP_SRC_MAC_P + i] = macaddr[i];
-    i++;
-  }
-  i = 0;
-  while (i < 4) {
-    buf[ETH_ARP_DST_IP_P + i] = buf[ETH_ARP_SRC_IP_P + i];
-    buf[ETH_ARP_SRC_IP_P + i] = ipaddr[i];
-    i++;
-  }
+  memcpy(&buf[ETH_ARP_DST_MAC_P], &buf[ETH_ARP_SRC_MAC_P], 6);
+  PUT_MY_MAC(&buf[ETH_ARP_SRC_MAC_P]);
+  memcpy(&buf[ETH_ARP_DST_IP_P], &buf[ETH_ARP_SRC_IP_P], 4);
+  PUT_MY_IP(&buf[ETH_ARP_SRC_IP_P]);
   /* eth+arp is 42 bytes. */
   ENC28J60_PacketSend(42, buf);
+  STATS_INC(arp_replies);
 }
 
+#if NET_FEATURE_ICMP
+/* Reply to the echo request currently in the receive buffer.
+ * len is the full length of the request, buf only needs to contain
+ * its first ICMP_DATA_P bytes.
+ */
 void NET_make_echo_reply_from_request(uint8_t *buf, uint16_t len) {
+  uint16_t sum;
+  uint8_t category = SPI_CATEGORY_SELECTED();
   make_eth(buf);
   make_ip(buf);
   buf[ICMP_TYPE_P] = ICMP_TYPE_ECHOREPLY_V;
-  /* we changed only the icmp.type field from request(=8) to reply(=0).
-   * we can therefore easily correct the checksum:
+  /* Only the type changed from request to reply, so the checksum is
+   * updated as in RFC 1624: HC' = ~(~HC + ~m + m').
+   */
+  sum = (buf[ICMP_CHECKSUM_P] << 8) | buf[ICMP_CHECKSUM_P + 1];
+  sum = checksum_add_u16(sum ^ 0xffff,
+                         (ICMP_TYPE_ECHOREQUEST_V << 8) ^ 0xffff);
+  sum = checksum_add_u16(sum, ICMP_TYPE_ECHOREPLY_V << 8) ^ 0xffff;
+  buf[ICMP_CHECKSUM_P] = sum >> 8;
+  buf[ICMP_CHECKSUM_P + 1] = sum & 0xff;
+  /* Only the headers are sent from buf, the payload is copied by the DMA
+   * controller from the request which is still in the receive buffer.
+   * This way replies are not limited by the size of buf.
    */
-  if (buf[ICMP_CHECKSUM_P] > (0xff - 0x08)) {
-    buf[ICMP_CHECKSUM_P + 1]++;
+  ENC28J60_PacketBegin();
+  SPI_CATEGORY(SPI_CAT_TX_HEADER);
+  ENC28J60_WriteBuffer(ICMP_DATA_P, buf);
+  SPI_CATEGORY(category);
+  if (len > ICMP_DATA_P) {
+    ENC28J60_DmaCopy(ENC28J60_PacketAddr(ICMP_DATA_P),
+                     len - ICMP_DATA_P,
+                     TX_PACKET_ADDR(ICMP_DATA_P));
+  }
+  ENC28J60_PacketCommit(len);
+  STATS_INC(echo_replies);
+}
+#endif
+
+#if NET_FEATURE_UDP
+/* Remember MAC address of the given IP, replacing the oldest entry. */
+static void arp_cache_update(uint8_t *ip, uint8_t *mac) {
+  NET_ARP_ENTRY *entry;
+  uint8_t i;
+  for (i = 0; i < NET_ARP_CACHE_ENTRIES; i++) {
+    if (memcmp(arp_cache[i].ip, ip, 4) == 0 && IS_MY_IFACE(&arp_cache[i])) {
+      memcpy(arp_cache[i].mac, mac, 6);
+      return;
+    }
+  }
+  entry = &arp_cache[arp_cache_next];
+  memcpy(entry->ip, ip, 4);
+  memcpy(entry->mac, mac, 6);
+  entry->iface = ENC28J60_Selected();
+  if (++arp_cache_next == NET_ARP_CACHE_ENTRIES) {
+    arp_cache_next = 0;
+  }
+}
+
+static NET_ARP_ENTRY *arp_cache_lookup(const uint8_t *ip) {
+  uint8_t i;
+  for (i = 0; i < NET_ARP_CACHE_ENTRIES; i++) {
+    if (memcmp(arp_cache[i].ip, ip, 4) == 0 && IS_MY_IFACE(&arp_cache[i])) {
+      return &arp_cache[i];
+    }
+  }
+  return 0;
+}
+#endif
+
+/* Decode packet headers in a single pass.
+ * Returns one of NET_PROTO_*, for UDP and TCP the destination port is
+ * stored in port. NET_PROTO_NONE is returned for packets which are not
+ * for us.
+ */
+uint8_t NET_classify(uint8_t *buf, uint16_t len, uint16_t *port) {
+  /* eth+ip+udp header is 42, same as the arp packet. */
+  if (len < 42) {
+    return NET_PROTO_NONE;
+  }
+  if (buf[ETH_TYPE_H_P] != ETHTYPE_IP_H_V) {
+    return NET_PROTO_NONE;
+  }
+  if (buf[ETH_TYPE_L_P] == ETHTYPE_ARP_L_V) {
+    if (!IS_MY_IP(&buf[ETH_ARP_DST_IP_P])) {
+      return NET_PROTO_NONE;
+    }
+    return NET_PROTO_ARP;
+  }
+  if (buf[ETH_TYPE_L_P] != ETHTYPE_IP_L_V ||
+      buf[IP_HEADER_LEN_VER_P] != 0x45 ||
+      !IS_MY_IP(&buf[IP_DST_P]))
+  {
+    return NET_PROTO_NONE;
+  }
+  switch (buf[IP_PROTO_P]) {
+    case IP_PROTO_ICMP_V:
+      return NET_PROTO_ICMP;
+    case IP_PROTO_UDP_V:
+      /* UDP and TCP ports are at the same position. */
+      *port = (buf[UDP_DST_PORT_H_P] << 8) | buf[UDP_DST_PORT_L_P];
+      return NET_PROTO_UDP;
+    case IP_PROTO_TCP_V:
+      *port = (buf[TCP_DST_PORT_H_P] << 8) | buf[TCP_DST_PORT_L_P];
+      return NET_PROTO_TCP;
+  }
+  return NET_PROTO_NONE;
+}
+
+/* Register handler for packets of the given protocol. port is only used
+ * for NET_PROTO_UDP and NET_PROTO_TCP, TCP ports which have a listener
+ * are handled by the listener.
+ * Returns 0 if the handler table is full.
+ */
+uint8_t NET_register_handler(uint8_t proto,
+                             uint16_t port,
+                             NET_HANDLER handler) {
+  if (num_handlers == NET_MAX_HANDLERS) {
+    return 0;
   }
-  buf[ICMP_CHECKSUM_P] += 0x08;
-  ENC28J60_PacketSend(len, buf);
+  handlers[num_handlers].proto = proto;
+  handlers[num_handlers].port = port;
+  handlers[num_handlers].handler = handler;
+  num_handlers++;
+  return 1;
 }
 
-/* You can send a max of 220 bytes of data. */
+/* Classify the packet and pass it to the registered handler.
+ * Returns 0 if nobody is interested in the packet.
+ */
+uint8_t NET_dispatch(uint8_t *buf, uint16_t len) {
+  uint16_t port = 0;
+  uint8_t proto, i;
+  proto = NET_classify(buf, len, &port);
+  if (proto == NET_PROTO_NONE) {
+    STATS_INC(rx_dropped);
+    return 0;
+  }
+#if NET_FEATURE_TCP_SERVER
+  if (proto == NET_PROTO_TCP) {
+    for (i = 0; i < num_tcp_listeners; i++) {
+      if (tcp_listeners[i].port == port) {
+        tcp_input(&tcp_listeners[i], buf);
+        return 1;
+      }
+    }
+  }
+#endif
+  for (i = 0; i < num_handlers; i++) {
+    if (handlers[i].proto == proto && handlers[i].port == port) {
+#if NET_FEATURE_UDP
+      if (proto == NET_PROTO_UDP) {
+        /* Replies are sent with NET_udp_sendto(), make sure it knows
+         * where to.
+         */
+        arp_cache_update(&buf[IP_SRC_P], &buf[ETH_SRC_MAC]);
+      }
+#endif
+      handlers[i].handler(buf, len);
+      return 1;
+    }
+  }
+  STATS_INC(rx_dropped);
+  return 0;
+}
+
+/* Default handlers of ARP and ICMP. */
+void NET_handle_arp(uint8_t *buf, uint16_t len) {
+  (void)len;
+#if NET_FEATURE_UDP
+  /* Whoever asks for us is likely to be talked to. */
+  arp_cache_update(&buf[ETH_ARP_SRC_IP_P], &buf[ETH_ARP_SRC_MAC_P]);
+#endif
+  if (buf[ETH_ARP_OPCODE_H_P] == ARP_OPCODE_REQUEST_H_V &&
+      buf[ETH_ARP_OPCODE_L_P] == ARP_OPCODE_REQUEST_L_V)
+  {
+    NET_make_arp_answer_from_request(buf);
+  }
+}
+
+#if NET_FEATURE_ICMP
+void NET_handle_icmp(uint8_t *buf, uint16_t len) {
+  (void)len;
+  if (buf[ICMP_TYPE_P] == ICMP_TYPE_ECHOREQUEST_V) {
+    NET_make_echo_reply_from_request(buf, ENC28J60_PacketLength());
+  }
+}
+#endif
+
+#if NET_FEATURE_UDP
+/* Reply to the received UDP packet with datalen bytes of data sent to the
+ * given port, from the port the packet was received on.
+ */
 void NET_make_udp_reply_from_request(uint8_t *buf,
-                                     char *data,
-                                     uint8_t datalen,
+                                     const char *data,
+                                     uint16_t datalen,
                                      uint16_t port) {
-  uint8_t i = 0;
+  arp_cache_update(&buf[IP_SRC_P], &buf[ETH_SRC_MAC]);
+  NET_udp_sendto(&buf[IP_SRC_P],
+                 port,
+                 (buf[UDP_DST_PORT_H_P] << 8) | buf[UDP_DST_PORT_L_P],
+                 (const uint8_t *)data,
+                 datalen);
+}
+#endif
+
+#if NET_FEATURE_TCP_SERVER
+/* ** TCP connection tracking. ** */
+
+static uint32_t tcp_next_isn(void) {
+  uint32_t isn;
+  /* We step only the second byte, this allows us to send packts
+   * with 255 bytes or 512 (if we step the initial seqnum by 2).
+   */
+  isn = (uint16_t)seqnum << 8;
+  /* Step the inititial seq num by something we will not use
+   * during this tcp session.
+   */
+  seqnum += 2;
+  return isn;
+}
+
+static uint8_t tcp_connection_is_free(NET_TCP_CONNECTION *connection,
+                                      uint16_t now) {
+  uint16_t age = now - connection->timestamp;
+  if (connection->state == TCP_STATE_CLOSED) {
+    return 1;
+  }
+  if (connection->state == TCP_STATE_SYN_RECEIVED) {
+    return age > NET_TCP_SYN_TIMEOUT;
+  }
+  return age > NET_TCP_TIMEOUT;
+}
+
+/* Find connection the received segment belongs to. */
+static int8_t tcp_lookup(uint8_t *buf, uint16_t now) {
+  uint8_t *header;
+  int8_t i;
+  for (i = 0; i < NET_TCP_MAX_CONNECTIONS; i++) {
+    if (tcp_connection_is_free(&tcp_connections[i], now)) {
+      continue;
+    }
+    /* Template is for the other direction, ports and addresses are
+     * swapped.
+     */
+    header = tcp_connections[i].header;
+    if (IS_MY_IFACE(&tcp_connections[i]) &&
+        header[TCP_DST_PORT_L_P] == buf[TCP_SRC_PORT_L_P] &&
+        header[TCP_DST_PORT_H_P] == buf[TCP_SRC_PORT_H_P] &&
+        header[TCP_SRC_PORT_L_P] == buf[TCP_DST_PORT_L_P] &&
+        header[TCP_SRC_PORT_H_P] == buf[TCP_DST_PORT_H_P] &&
+        memcmp(&header[IP_DST_P], &buf[IP_SRC_P], 4) == 0)
+    {
+      return i;
+    }
+  }
+  return NET_TCP_NO_CONNECTION;
+}
+
+/* Fill in header template of the connection from the received segment. */
+static void tcp_make_template(NET_TCP_CONNECTION *connection, uint8_t *buf) {
+  uint8_t *header = connection->header;
+  uint16_t sum;
+  memset(header, 0, sizeof(connection->header));
+  connection->iface = ENC28J60_Selected();
+  memcpy(&header[ETH_DST_MAC], &buf[ETH_SRC_MAC], 6);
+  PUT_MY_MAC(&header[ETH_SRC_MAC]);
+  header[ETH_TYPE_H_P] = ETHTYPE_IP_H_V;
+  header[ETH_TYPE_L_P] = ETHTYPE_IP_L_V;
+  header[IP_P] = IP_V4_V | IP_HEADER_LENGTH_V;
+  header[IP_FLAGS_P] = 0x40;  /* Don't fragment. */
+  header[IP_TTL_P] = 64;
+  header[IP_PROTO_P] = IP_PROTO_TCP_V;
+  PUT_MY_IP(&header[IP_SRC_P]);
+  memcpy(&header[IP_DST_P], &buf[IP_SRC_P], 4);
+  header[TCP_SRC_PORT_H_P] = buf[TCP_DST_PORT_H_P];
+  header[TCP_SRC_PORT_L_P] = buf[TCP_DST_PORT_L_P];
+  header[TCP_DST_PORT_H_P] = buf[TCP_SRC_PORT_H_P];
+  header[TCP_DST_PORT_L_P] = buf[TCP_SRC_PORT_L_P];
+  /* No options, 20 bytes. */
+  header[TCP_HEADER_LEN_P] = 0x50;
+  header[TCP_WINDOWSIZE_H_P] = NET_TCP_WINDOW >> 8;
+  header[TCP_WINDOWSIZE_L_P] = NET_TCP_WINDOW & 0xff;
+  /* Variable fields are all zero in the template, so the sums are just
+   * the sums over the whole headers.
+   */
+  connection->ip_sum = checksum_add(0, &header[IP_P], IP_HEADER_LEN);
+  /* Pseudo header addresses and protocol, then the TCP header itself. */
+  sum = checksum_add(IP_PROTO_TCP_V, &header[IP_SRC_P], 8);
+  connection->tcp_sum = checksum_add(sum,
+                                     &header[TCP_SRC_PORT_H_P],
+                                     TCP_HEADER_LEN_PLAIN);
+}
+
+static uint8_t tcp_free_count(uint16_t now) {
+  uint8_t i, count = 0;
+  for (i = 0; i < NET_TCP_MAX_CONNECTIONS; i++) {
+    if (tcp_connection_is_free(&tcp_connections[i], now)) {
+      count++;
+    }
+  }
+  return count;
+}
+
+/* Allocate connection entry for the received segment.
+ *
+ * If steal is non-zero and the table is full the oldest half-open
+ * connection is reused, it is most likely a leftover of a SYN flood.
+ */
+static int8_t tcp_alloc(uint8_t *buf, uint16_t now, uint8_t steal) {
+  NET_TCP_CONNECTION *connection;
+  int8_t i, conn = NET_TCP_NO_CONNECTION;
+  for (i = 0; i < NET_TCP_MAX_CONNECTIONS; i++) {
+    connection = &tcp_connections[i];
+    if (tcp_connection_is_free(connection, now)) {
+      conn = i;
+      break;
+    }
+    if (steal && connection->state == TCP_STATE_SYN_RECEIVED &&
+        (conn == NET_TCP_NO_CONNECTION ||
+         (uint16_t)(now - connection->timestamp) >
+         (uint16_t)(now - tcp_connections[conn].timestamp)))
+    {
+      conn = i;
+    }
+  }
+  if (conn == NET_TCP_NO_CONNECTION) {
+    return conn;
+  }
+  connection = &tcp_connections[conn];
+  tcp_make_template(connection, buf);
+  connection->timestamp = now;
+  return conn;
+}
+
+static uint8_t tcp_syncookie_time(void) {
+  return TIMER_GetSeconds() >> NET_TCP_SYNCOOKIE_SHIFT;
+}
+
+static uint32_t syncookie_hash_step(uint32_t hash, uint8_t value) {
+  hash += value;
+  hash += hash << 10;
+  hash ^= hash >> 6;
+  return hash;
+}
+
+/* Jenkins one-at-a-time hash of the segment 4-tuple and the coarse
+ * timestamp, keyed with the secret. Our own address is not hashed since
+ * it never changes.
+ */
+static uint32_t tcp_syncookie(uint8_t *buf, uint8_t time) {
+  uint32_t hash = syncookie_secret;
+  uint8_t i;
+  for (i = 0; i < 4; i++) {
+    hash = syncookie_hash_step(hash, buf[IP_SRC_P + i]);
+  }
+  /* Source and destination ports. */
+  for (i = 0; i < 4; i++) {
+    hash = syncookie_hash_step(hash, buf[TCP_SRC_PORT_H_P + i]);
+  }
+  hash = syncookie_hash_step(hash, time);
+  hash += hash << 3;
+  hash ^= hash >> 11;
+  hash += hash << 15;
+  return hash;
+}
+
+/* Seed the secret the first time a cookie is needed. The moment the table
+ * fills up is not really predictable from outside, the uptime and the MAC
+ * address also make the secret differ between boots and boards.
+ */
+static void tcp_syncookie_seed(uint16_t now) {
+  uint32_t hash = 0x5bd1e995;
+  uint16_t millis = TIMER_GetMillis();
+  uint8_t mac[6];
+  uint8_t i;
+  PUT_MY_MAC(mac);
+  for (i = 0; i < 6; i++) {
+    hash = syncookie_hash_step(hash, mac[i]);
+  }
+  hash = syncookie_hash_step(hash, now >> 8);
+  hash = syncookie_hash_step(hash, now & 0xff);
+  hash = syncookie_hash_step(hash, millis >> 8);
+  hash = syncookie_hash_step(hash, millis & 0xff);
+  syncookie_secret = syncookie_hash_step(hash, ip_identifier & 0xff);
+}
+
+/* Number of connections to the given local port. */
+static uint8_t tcp_port_connections(uint16_t port, uint16_t now) {
+  NET_TCP_CONNECTION *connection;
+  uint8_t i, count = 0;
+  for (i = 0; i < NET_TCP_MAX_CONNECTIONS; i++) {
+    connection = &tcp_connections[i];
+    if (!tcp_connection_is_free(connection, now) &&
+        connection->header[TCP_SRC_PORT_H_P] == (port >> 8) &&
+        connection->header[TCP_SRC_PORT_L_P] == (port & 0xff))
+    {
+      count++;
+    }
+  }
+  return count;
+}
+
+/* Reset the connection the received segment belongs to, without any state
+ * on our side. The reset takes the sequence number the segment
+ * acknowledges.
+ */
+static void tcp_send_reset(uint8_t *buf) {
   uint16_t ck;
   make_eth(buf);
-  if (datalen > 220) {
-    datalen = 220;
-  }
-  /* Total length field in the IP header must be set. */
+  make_tcphead(buf, 0, 0, 1);
+  buf[TCP_FLAGS_P] = TCP_FLAG_RST_V;
   buf[IP_TOTLEN_H_P] = 0;
-  buf[IP_TOTLEN_L_P] = IP_HEADER_LEN + UDP_HEADER_LEN + datalen;
+  buf[IP_TOTLEN_L_P] = IP_HEADER_LEN + TCP_HEADER_LEN_PLAIN;
   make_ip(buf);
-  buf[UDP_DST_PORT_H_P] = port >> 8;
-  buf[UDP_DST_PORT_L_P] = port & 0xff;
-  /* Source port does not matter and is what the sender used. */
-  /* Calculte the udp length. */
-  buf[UDP_LEN_H_P] = 0;
-  buf[UDP_LEN_L_P] = UDP_HEADER_LEN + datalen;
-  /* Zero the checksum. */
-  buf[UDP_CHECKSUM_H_P] = 0;
-  buf[UDP_CHECKSUM_L_P] = 0;
-  /* Copy the data. */
-  while (i < datalen) {
-    buf[UDP_DATA_P + i] = data[i];
-    i++;
-  }
-  ck = checksum(&buf[IP_SRC_P], 16 + datalen, CHECKSUM_TYPE_UDP);
-  buf[UDP_CHECKSUM_H_P] = ck >> 8;
-  buf[UDP_CHECKSUM_L_P] = ck & 0xff;
-  ENC28J60_PacketSend(UDP_HEADER_LEN + IP_HEADER_LEN + ETH_HEADER_LEN + datalen,
+  ck = checksum(&buf[IP_SRC_P], 8 + TCP_HEADER_LEN_PLAIN, CHECKSUM_TYPE_TCP);
+  buf[TCP_CHECKSUM_H_P] = ck >> 8;
+  buf[TCP_CHECKSUM_L_P] = ck & 0xff;
+  ENC28J60_PacketSend(ETH_HEADER_LEN + IP_HEADER_LEN + TCP_HEADER_LEN_PLAIN,
                       buf);
 }
 
+/* Look up connection the received segment belongs to.
+ *
+ * Completes the handshake for connections in SYN_RECEIVED state, and
+ * allocates state for the handshakes done with SYN cookies once the
+ * cookie is validated.
+ *
+ * Returns NET_TCP_NO_CONNECTION if the segment is to be dropped.
+ */
+static int8_t tcp_get_connection(uint8_t *buf,
+                                 uint8_t max_connections,
+                                 uint8_t *accepted) {
+  NET_TCP_CONNECTION *connection;
+  uint16_t now = TIMER_GetSeconds();
+  uint32_t ack = get_u32(&buf[TCP_SEQACK_H_P]);
+  uint16_t dlen;
+  uint8_t time, flags;
+  int8_t conn;
+  conn = tcp_lookup(buf, now);
+  if (conn != NET_TCP_NO_CONNECTION) {
+    connection = &tcp_connections[conn];
+    if (buf[TCP_FLAGS_P] & TCP_FLAG_RST_V) {
+      connection->state = TCP_STATE_CLOSED;
+      STATS_INC(tcp_resets);
+      return NET_TCP_NO_CONNECTION;
+    }
+    if (connection->state == TCP_STATE_SYN_RECEIVED) {
+      if (ack != connection->snd_nxt) {
+        return NET_TCP_NO_CONNECTION;
+      }
+      connection->state = TCP_STATE_ESTABLISHED;
+      connection->snd_una = ack;
+      *accepted = 1;
+    }
+    /* Acknowledgements of anything we have not sent are ignored. */
+    if ((uint32_t)(ack - connection->snd_una) <=
+        (uint32_t)(connection->snd_nxt - connection->snd_una))
+    {
+      connection->snd_una = ack;
+    }
+    dlen = NET_tcp_get_dlength(buf);
+    if (dlen) {
+      /* Every request is answered with a single data segment, so a
+       * retransmitted request is to be answered starting from what the
+       * other side has acknowledged.
+       */
+      connection->snd_nxt = ack;
+    }
+    connection->rcv_nxt = get_u32(&buf[TCP_SEQ_H_P]) + dlen;
+    if (buf[TCP_FLAGS_P] & TCP_FLAG_FIN_V) {
+      connection->rcv_nxt++;
+    }
+    connection->timestamp = now;
+    return conn;
+  }
+  /* Could be the final ACK of a handshake done with SYN cookie, which
+   * is a bare ACK. Anything else is dropped before any hashing. Accept
+   * cookies from the current and the previous time slot.
+   */
+  flags = buf[TCP_FLAGS_P] &
+          (TCP_FLAG_SYN_V | TCP_FLAG_FIN_V | TCP_FLAG_RST_V | TCP_FLAG_ACK_V);
+  if (flags != TCP_FLAG_ACK_V || NET_tcp_get_dlength(buf) != 0) {
+    return NET_TCP_NO_CONNECTION;
+  }
+  time = tcp_syncookie_time();
+  if (syncookie_secret == 0 ||
+      (ack - 1 != tcp_syncookie(buf, time) &&
+       ack - 1 != tcp_syncookie(buf, time - 1)))
+  {
+    return NET_TCP_NO_CONNECTION;
+  }
+  /* Same quota as for the SYN of a handshake with state. */
+  if (tcp_port_connections((buf[TCP_DST_PORT_H_P] << 8) |
+                           buf[TCP_DST_PORT_L_P], now) >= max_connections)
+  {
+    tcp_send_reset(buf);
+    STATS_INC(tcp_resets);
+    return NET_TCP_NO_CONNECTION;
+  }
+  conn = tcp_alloc(buf, now, 1);
+  if (conn != NET_TCP_NO_CONNECTION) {
+    connection = &tcp_connections[conn];
+    connection->state = TCP_STATE_ESTABLISHED;
+    connection->snd_nxt = ack;
+    connection->snd_una = ack;
+    connection->rcv_nxt = get_u32(&buf[TCP_SEQ_H_P]);
+    *accepted = 1;
+  }
+  return conn;
+}
+
+int8_t NET_tcp_get_connection(uint8_t *buf) {
+  uint8_t accepted = 0;
+  return tcp_get_connection(buf, NET_TCP_MAX_CONNECTIONS, &accepted);
+}
+
+void NET_tcp_close(int8_t conn) {
+  if (conn != NET_TCP_NO_CONNECTION) {
+    tcp_connections[conn].state = TCP_STATE_CLOSED;
+  }
+}
+
+/* Non-zero if the connection is established and did not time out. */
+uint8_t NET_tcp_is_established(int8_t conn) {
+  return tcp_connections[conn].state == TCP_STATE_ESTABLISHED &&
+         !tcp_connection_is_free(&tcp_connections[conn], TIMER_GetSeconds());
+}
+
+/* Number of bytes sent on the connection and not acknowledged yet. */
+uint16_t NET_tcp_unacked(int8_t conn) {
+  return (uint16_t)(tcp_connections[conn].snd_nxt -
+                    tcp_connections[conn].snd_una);
+}
+
+/* Rewind the connection to the first unacknowledged byte, so the data
+ * which seems to be lost is sent again with the next NET_tcp_send().
+ * There are no retransmission timers in the stack, this is up to the
+ * applications which send data on their own.
+ */
+void NET_tcp_rewind(int8_t conn) {
+  tcp_connections[conn].snd_nxt = tcp_connections[conn].snd_una;
+}
+
+/* Start accepting connections on the given port.
+ *
+ * accept is called once the handshake is complete and may refuse the
+ * connection by returning 0, it could be 0 itself. receive is called for
+ * every segment with data, which is then to be read with NET_tcp_fetch().
+ * Segments without data are handled by the stack.
+ *
+ * Returns 0 if the listener table is full.
+ */
+uint8_t NET_tcp_listen(uint16_t port,
+                       uint8_t max_connections,
+                       NET_TCP_ACCEPT accept,
+                       NET_TCP_RECEIVE receive) {
+  NET_TCP_LISTENER *listener;
+  if (num_tcp_listeners == NET_TCP_MAX_LISTENERS) {
+    return 0;
+  }
+  listener = &tcp_listeners[num_tcp_listeners++];
+  listener->port = port;
+  listener->max_connections = max_connections;
+  listener->accept = accept;
+  listener->receive = receive;
+  return 1;
+}
+
+/* Handle segment for the listener, only headers are expected in buf. */
+static void tcp_input(NET_TCP_LISTENER *listener, uint8_t *buf) {
+  uint16_t now = TIMER_GetSeconds();
+  uint8_t accepted = 0;
+  int8_t conn;
+  if (buf[TCP_FLAGS_P] & TCP_FLAGS_SYN_V) {
+    /* Retransmitted SYN of connection we already have is fine. */
+    if (tcp_lookup(buf, now) != NET_TCP_NO_CONNECTION ||
+        tcp_port_connections(listener->port, now) < listener->max_connections)
+    {
+      NET_make_tcp_synack_from_syn(buf);
+    }
+    return;
+  }
+  if ((buf[TCP_FLAGS_P] & TCP_FLAGS_ACK_V) == 0) {
+    return;
+  }
+  conn = tcp_get_connection(buf, listener->max_connections, &accepted);
+  if (conn == NET_TCP_NO_CONNECTION) {
+    /* Unknown connection or invalid SYN cookie. */
+    return;
+  }
+  if (accepted && listener->accept != 0 && listener->accept(conn) == 0) {
+    NET_tcp_send(conn, buf, TCP_FLAG_RST_V | TCP_FLAG_ACK_V, 0);
+    NET_tcp_close(conn);
+    STATS_INC(tcp_resets);
+    return;
+  }
+  if (accepted) {
+    STATS_INC(tcp_accepted);
+  }
+  if (NET_tcp_get_dlength(buf) == 0) {
+    if (buf[TCP_FLAGS_P] & TCP_FLAGS_FIN_V) {
+      NET_tcp_send(conn, buf, TCP_FLAG_ACK_V, 0);
+      NET_tcp_close(conn);
+    }
+    return;
+  }
+  listener->receive(conn, buf);
+}
+
+/* Read data of the received segment into buf which is size bytes big,
+ * the headers are expected to be there already.
+ * Returns position of the data in buf, 0 if there is no data.
+ */
+uint16_t NET_tcp_fetch(uint8_t *buf, uint16_t size) {
+  uint16_t len = ENC28J60_PacketLength();
+  if (len > size - 1) {
+    len = size - 1;
+    STATS_INC(rx_truncated);
+  }
+  if (len > TCP_DATA_P) {
+    ENC28J60_PacketRead(TCP_DATA_P, len - TCP_DATA_P, &buf[TCP_DATA_P]);
+  }
+  NET_init_len_info(buf);
+  return NET_get_tcp_data_pointer();
+}
+
+/* Fill in header of a segment with dlen bytes of tcp data from the
+ * connection template. Only the varying fields are patched and checksums
+ * are finished from the precomputed partial sums, payload_sum is the partial
+ * sum of the tcp data.
+ */
+static void tcp_fill_header(NET_TCP_CONNECTION *connection,
+                            uint8_t *buf,
+                            uint8_t flags,
+                            uint16_t dlen,
+                            uint16_t payload_sum) {
+  uint16_t sum, len;
+  PROF_BEGIN(PROF_HEADER);
+  memcpy(buf, connection->header, TCP_OPTIONS_P);
+  /* IP header. */
+  len = IP_HEADER_LEN + TCP_HEADER_LEN_PLAIN + dlen;
+  buf[IP_TOTLEN_H_P] = len >> 8;
+  buf[IP_TOTLEN_L_P] = len & 0xff;
+  buf[IP_ID_H_P] = ip_identifier >> 8;
+  buf[IP_ID_L_P] = ip_identifier & 0xff;
+  sum = checksum_add_u16(connection->ip_sum, len);
+  sum = checksum_add_u16(sum, ip_identifier) ^ 0xffff;
+  buf[IP_CHECKSUM_H_P] = sum >> 8;
+  buf[IP_CHECKSUM_L_P] = sum & 0xff;
+  ip_identifier++;
+  /* TCP header. */
+  put_u32(&buf[TCP_SEQ_H_P], connection->snd_nxt);
+  put_u32(&buf[TCP_SEQACK_H_P], connection->rcv_nxt);
+  buf[TCP_FLAGS_P] = flags;
+  sum = checksum_add_u16(connection->tcp_sum, TCP_HEADER_LEN_PLAIN + dlen);
+  sum = checksum_add(sum, &buf[TCP_SEQ_H_P], 8);
+  sum = checksum_add_u16(sum, flags);
+  sum = checksum_add_u16(sum, payload_sum) ^ 0xffff;
+  buf[TCP_CHECKSUM_H_P] = sum >> 8;
+  buf[TCP_CHECKSUM_L_P] = sum & 0xff;
+  /* FIN occupies one sequence number. */
+  connection->snd_nxt += dlen;
+  if (flags & TCP_FLAG_FIN_V) {
+    connection->snd_nxt++;
+  }
+  connection->timestamp = TIMER_GetSeconds();
+  PROF_END(PROF_HEADER);
+}
+
+/* Send segment with dlen bytes of tcp data which are already in buf at
+ * TCP_DATA_P. It goes out on the interface of the connection, the selected
+ * interface is kept.
+ */
+void NET_tcp_send(int8_t conn, uint8_t *buf, uint8_t flags, uint16_t dlen) {
+  uint8_t iface = ENC28J60_Selected();
+  ENC28J60_Select(tcp_connections[conn].iface);
+  tcp_fill_header(&tcp_connections[conn],
+                  buf,
+                  flags,
+                  dlen,
+                  checksum_add(0, &buf[TCP_DATA_P], dlen));
+  ENC28J60_PacketSend(TCP_DATA_P + dlen, buf);
+  ENC28J60_Select(iface);
+}
+
+/* Convert value to decimal, returns number of characters. */
+static uint8_t format_u16(char *str, uint16_t value) {
+  char digits[5];
+  uint8_t i = 0, len = 0;
+  do {
+    digits[i++] = '0' + value % 10;
+    value /= 10;
+  } while (value);
+  while (i) {
+    str[len++] = digits[--i];
+  }
+  return len;
+}
+
+/* Rendering state of a page: number of segments to render, total length
+ * and partial sum of the rendered data and the formatted Content-Length.
+ */
+typedef struct {
+  uint8_t num_segments;
+  uint16_t len;
+  uint16_t sum;
+  uint8_t length_len;
+  char length[5];
+} NET_PAGE_RENDER;
+
+static void page_measure(const NET_PAGE *page,
+                         const char **fields,
+                         NET_PAGE_RENDER *render) {
+  const NET_PAGE_SEGMENT *segment;
+  uint16_t body_len = page->body_len, len, sum;
+  uint8_t i;
+  /* Fields lengths are needed for the Content-Length. */
+  segment = page->segments;
+  for (i = 0; i < page->num_segments; i++, segment++) {
+    if (segment->type == NET_PAGE_SEGMENT_FIELD) {
+      body_len += strlen(fields[segment->len]);
+    }
+  }
+  render->length_len = format_u16(render->length, body_len);
+  render->len = 0;
+  render->sum = 0;
+  segment = page->segments;
+  for (i = 0; i < render->num_segments; i++, segment++) {
+    if (segment->type == NET_PAGE_SEGMENT_STATIC) {
+      len = segment->len;
+      sum = segment->sum;
+    } else if (segment->type == NET_PAGE_SEGMENT_FIELD) {
+      len = strlen(fields[segment->len]);
+      sum = checksum_add(0, (const uint8_t *)fields[segment->len], len);
+    } else {
+      len = render->length_len;
+      sum = checksum_add(0, (const uint8_t *)render->length, len);
+    }
+    render->sum = checksum_add_u16(render->sum,
+                                   page_segment_sum(sum, render->len));
+    render->len += len;
+  }
+}
+
+/* Write rendered page at the current write pointer. */
+static void page_write(const NET_PAGE *page,
+                       const char **fields,
+                       NET_PAGE_RENDER *render) {
+  const NET_PAGE_SEGMENT *segment;
+  uint8_t category = SPI_CATEGORY_SELECTED();
+  uint8_t i;
+  SPI_CATEGORY(SPI_CAT_TX_PAYLOAD);
+  segment = page->segments;
+  for (i = 0; i < render->num_segments; i++, segment++) {
+    if (segment->type == NET_PAGE_SEGMENT_STATIC) {
+      ENC28J60_WriteBuffer(segment->len, segment->data);
+    } else if (segment->type == NET_PAGE_SEGMENT_FIELD) {
+      ENC28J60_WriteBuffer(strlen(fields[segment->len]),
+                           (const uint8_t *)fields[segment->len]);
+    } else {
+      ENC28J60_WriteBuffer(render->length_len,
+                           (const uint8_t *)render->length);
+    }
+  }
+  SPI_CATEGORY(category);
+}
+
+/* Cache of rendered pages in the ENC28J60 buffer memory. */
+typedef struct {
+  const NET_PAGE *page;
+  /* Interface the page is cached on, and the memory there. */
+  uint8_t iface;
+  uint16_t addr;
+  uint16_t len;
+  uint16_t sum;
+} NET_PAGE_CACHE_ENTRY;
+
+/* Entries are kept in the order of use, the least recently used first. */
+static NET_PAGE_CACHE_ENTRY page_cache[NET_PAGE_CACHE_ENTRIES];
+static uint8_t page_cache_used = 0;
+
+/* Drop entry i from the cache and free its memory. */
+static void page_cache_evict(uint8_t i) {
+  uint8_t iface = ENC28J60_Selected();
+  ENC28J60_Select(page_cache[i].iface);
+  ENC28J60_MemFree(page_cache[i].addr, page_cache[i].len);
+  ENC28J60_Select(iface);
+  page_cache_used--;
+  memmove(&page_cache[i],
+          &page_cache[i + 1],
+          (page_cache_used - i) * sizeof(NET_PAGE_CACHE_ENTRY));
+}
+
+/* Must be called when values of page fields change. */
+void NET_page_cache_flush(void) {
+  while (page_cache_used != 0) {
+    page_cache_evict(page_cache_used - 1);
+  }
+}
+
+/* Find page in the cache, rendering it there if it is not cached yet.
+ * Returns 0 if the page can not be cached, render is measured then.
+ *
+ * The cache takes whatever the buffer memory allocator has left, pages
+ * which were not used for the longest time make room for a new one.
+ */
+static NET_PAGE_CACHE_ENTRY *page_cache_lookup(const NET_PAGE *page,
+                                               const char **fields,
+                                               NET_PAGE_RENDER *render) {
+  NET_PAGE_CACHE_ENTRY entry;
+  uint16_t addr;
+  uint8_t i;
+  for (i = 0; i < page_cache_used; i++) {
+    if (page_cache[i].page == page && IS_MY_IFACE(&page_cache[i])) {
+      /* Move it to the end, as the most recently used one. */
+      entry = page_cache[i];
+      page_cache_used--;
+      memmove(&page_cache[i],
+              &page_cache[i + 1],
+              (page_cache_used - i) * sizeof(NET_PAGE_CACHE_ENTRY));
+      page_cache[page_cache_used] = entry;
+      return &page_cache[page_cache_used++];
+    }
+  }
+  page_measure(page, fields, render);
+  if (ENC28J60_MEM_ROUND(render->len) >
+      ((uint16_t)ENC28J60_MEM_BLOCKS << ENC28J60_BLOCK_SHIFT))
+  {
+    return 0;
+  }
+  if (page_cache_used == NET_PAGE_CACHE_ENTRIES) {
+    page_cache_evict(0);
+  }
+  while ((addr = ENC28J60_MemAlloc(render->len)) == ENC28J60_NO_MEMORY) {
+    /* Free pages of this controller until the page fits, the memory could
+     * also be taken by someone else or fragmented.
+     */
+    i = 0;
+    while (i < page_cache_used && !IS_MY_IFACE(&page_cache[i])) {
+      i++;
+    }
+    if (i == page_cache_used) {
+      return 0;
+    }
+    page_cache_evict(i);
+  }
+  entry.page = page;
+  entry.iface = ENC28J60_Selected();
+  entry.addr = addr;
+  entry.len = render->len;
+  entry.sum = render->sum;
+  page_cache[page_cache_used] = entry;
+  ENC28J60_SetWritePointer(addr);
+  page_write(page, fields, render);
+  return &page_cache[page_cache_used++];
+}
+
+/* Send static page in a single segment, closing the connection.
+ *
+ * Pages are rendered once into the cache in the ENC28J60 buffer memory
+ * together with their partial checksum. From there on only the header goes
+ * over SPI and the page itself is copied into the transmit buffer by the
+ * DMA controller.
+ *
+ * Pages which do not fit into the cache are streamed from program memory,
+ * and only the header and fields are checksummed. So is the response
+ * header alone, which is sent when header_only is set.
+ *
+ * Like NET_tcp_send() the selected interface is kept.
+ */
+void NET_tcp_send_page(int8_t conn,
+                       uint8_t *buf,
+                       const NET_PAGE *page,
+                       const char **fields,
+                       uint8_t header_only) {
+  const uint8_t flags = TCP_FLAG_ACK_V | TCP_FLAG_PUSH_V | TCP_FLAG_FIN_V;
+  NET_PAGE_CACHE_ENTRY *entry;
+  NET_PAGE_RENDER render;
+  uint8_t iface = ENC28J60_Selected();
+  uint8_t category = SPI_CATEGORY_SELECTED();
+  /* Pages are cached in the memory of the connection's controller. */
+  ENC28J60_Select(tcp_connections[conn].iface);
+  if (header_only) {
+    render.num_segments = page->header_segments;
+    page_measure(page, fields, &render);
+    entry = 0;
+  } else {
+    render.num_segments = page->num_segments;
+    entry = page_cache_lookup(page, fields, &render);
+  }
+  if (entry != 0) {
+    tcp_fill_header(&tcp_connections[conn],
+                    buf,
+                    flags,
+                    entry->len,
+                    entry->sum);
+    ENC28J60_PacketBegin();
+    SPI_CATEGORY(SPI_CAT_TX_HEADER);
+    ENC28J60_WriteBuffer(TCP_DATA_P, buf);
+    SPI_CATEGORY(category);
+    ENC28J60_DmaCopy(entry->addr, entry->len, TX_PACKET_ADDR(TCP_DATA_P));
+    ENC28J60_PacketCommit(TCP_DATA_P + entry->len);
+  } else {
+    tcp_fill_header(&tcp_connections[conn],
+                    buf,
+                    flags,
+                    render.len,
+                    render.sum);
+    ENC28J60_PacketBegin();
+    SPI_CATEGORY(SPI_CAT_TX_HEADER);
+    ENC28J60_WriteBuffer(TCP_DATA_P, buf);
+    SPI_CATEGORY(category);
+    page_write(page, fields, &render);
+    ENC28J60_PacketCommit(TCP_DATA_P + render.len);
+  }
+  ENC28J60_Select(iface);
+}
+#endif
+
+#if NET_FEATURE_UDP
+/* ** UDP sockets. ** */
+
+/* Call receive for every datagram sent to the given port. Only headers
+ * are in buf then, data is to be read with NET_udp_fetch().
+ * Returns 0 if the handler table is full.
+ */
+uint8_t NET_udp_bind(uint16_t port, NET_HANDLER receive) {
+  return NET_register_handler(NET_PROTO_UDP, port, receive);
+}
+
+/* Read data of the received datagram into buf which is size bytes big,
+ * starting at UDP_DATA_P. Returns length of the data.
+ */
+uint16_t NET_udp_fetch(uint8_t *buf, uint16_t size) {
+  uint16_t len = ((buf[UDP_LEN_H_P] << 8) | buf[UDP_LEN_L_P]) - UDP_HEADER_LEN;
+  uint16_t frame_len = ENC28J60_PacketLength();
+  if (size <= UDP_DATA_P + 1 || frame_len <= UDP_DATA_P) {
+    return 0;
+  }
+  /* The length field is not to be trusted, data never goes past the
+   * frame we have received.
+   */
+  if (len > frame_len - UDP_DATA_P) {
+    len = frame_len - UDP_DATA_P;
+  }
+  if (len > size - 1 - UDP_DATA_P) {
+    len = size - 1 - UDP_DATA_P;
+    STATS_INC(rx_truncated);
+  }
+  ENC28J60_PacketRead(UDP_DATA_P, len, &buf[UDP_DATA_P]);
+  return len;
+}
+
+/* Start datagram to the given address in the buffer memory slot allocated
+ * with ENC28J60_MemAlloc(ENC28J60_TX_SLOT_SIZE(UDP_DATA_P + max data)).
+ * Data is then written with NET_udp_stream_write() and the datagram is sent
+ * with NET_udp_stream_send().
+ *
+ * The header written to the slot stays valid, so after sending the stream
+ * could be restarted with NET_udp_stream_reset() and only the data is to be
+ * written again.
+ *
+ * Returns 0 if MAC address of the peer is not known yet, an ARP request
+ * is sent then and the datagram is to be started again later.
+ */
+uint8_t NET_udp_stream_begin(NET_UDP_STREAM *stream,
+                             uint16_t slot,
+                             const uint8_t *ip,
+                             uint16_t port,
+                             uint16_t src_port) {
+  uint8_t header[UDP_DATA_P];
+  NET_ARP_ENTRY *entry = arp_cache_lookup(ip);
+  uint8_t category = SPI_CATEGORY_SELECTED();
+  if (entry == 0) {
+#if NET_FEATURE_ARP_CLIENT
+    NET_make_arp_request(header, (uint8_t *)ip);
+#endif
+    return 0;
+  }
+  memset(header, 0, sizeof(header));
+  make_eth_ip_new(header, entry->mac);
+  header[IP_P] = IP_V4_V | IP_HEADER_LENGTH_V;
+  header[IP_FLAGS_P] = 0x40;  /* Don't fragment. */
+  header[IP_TTL_P] = 64;
+  header[IP_PROTO_P] = IP_PROTO_UDP_V;
+  PUT_MY_IP(&header[IP_SRC_P]);
+  memcpy(&header[IP_DST_P], ip, 4);
+  header[UDP_SRC_PORT_H_P] = src_port >> 8;
+  header[UDP_SRC_PORT_L_P] = src_port & 0xff;
+  header[UDP_DST_PORT_H_P] = port >> 8;
+  header[UDP_DST_PORT_L_P] = port & 0xff;
+  /* Lengths and identification are left zero and added to the sums in
+   * NET_udp_stream_send(), every datagram sent from the slot gets an
+   * identification of its own.
+   */
+  stream->slot = slot;
+  stream->iface = ENC28J60_Selected();
+  stream->ip_sum = checksum_add(0, &header[IP_P], IP_HEADER_LEN);
+  stream->header_sum = checksum_add(IP_PROTO_UDP_V,
+                                    &header[IP_SRC_P],
+                                    8 + UDP_HEADER_LEN);
+  NET_udp_stream_reset(stream);
+  ENC28J60_PacketBeginAt(slot);
+  SPI_CATEGORY(SPI_CAT_TX_HEADER);
+  ENC28J60_WriteBuffer(UDP_DATA_P, header);
+  SPI_CATEGORY(category);
+  return 1;
+}
+
+/* Start over with no data, keeping the header. */
+void NET_udp_stream_reset(NET_UDP_STREAM *stream) {
+  stream->len = 0;
+  stream->sum = 0;
+}
+
+/* Append data to the datagram, anything beyond NET_UDP_MAX_DATA is
+ * dropped. Other packets could be sent in between the writes.
+ *
+ * Writing and sending use the interface the stream was started on, the
+ * selected interface is kept.
+ */
+void NET_udp_stream_write(NET_UDP_STREAM *stream,
+                          const uint8_t *data,
+                          uint16_t len) {
+  uint8_t iface = ENC28J60_Selected();
+  uint8_t category = SPI_CATEGORY_SELECTED();
+  if (len > NET_UDP_MAX_DATA - stream->len) {
+    len = NET_UDP_MAX_DATA - stream->len;
+  }
+  ENC28J60_Select(stream->iface);
+  ENC28J60_SetWritePointer(stream->slot + 1 + UDP_DATA_P + stream->len);
+  SPI_CATEGORY(SPI_CAT_TX_PAYLOAD);
+  ENC28J60_WriteBuffer(len, data);
+  SPI_CATEGORY(category);
+  stream->sum = checksum_add_u16(
+      stream->sum,
+      page_segment_sum(checksum_add(0, data, len), stream->len));
+  stream->len += len;
+  ENC28J60_Select(iface);
+}
+
+/* Finish the header and send the datagram. */
+void NET_udp_stream_send(NET_UDP_STREAM *stream) {
+  uint8_t field[4];
+  uint16_t header = stream->slot + 1;
+  uint16_t len = IP_HEADER_LEN + UDP_HEADER_LEN + stream->len;
+  uint16_t ck;
+  uint8_t iface = ENC28J60_Selected();
+  uint8_t category = SPI_CATEGORY_SELECTED();
+  ENC28J60_Select(stream->iface);
+  /* Only the header is patched, the data is written already. */
+  SPI_CATEGORY(SPI_CAT_TX_HEADER);
+  /* IP total length and identification, which follow each other, and
+   * header checksum.
+   */
+  field[0] = len >> 8;
+  field[1] = len & 0xff;
+  field[2] = ip_identifier >> 8;
+  field[3] = ip_identifier & 0xff;
+  ENC28J60_SetWritePointer(header + IP_TOTLEN_H_P);
+  ENC28J60_WriteBuffer(4, field);
+  ck = checksum_add_u16(stream->ip_sum, len);
+  ck = checksum_add_u16(ck, ip_identifier) ^ 0xffff;
+  ip_identifier++;
+  field[0] = ck >> 8;
+  field[1] = ck & 0xff;
+  ENC28J60_SetWritePointer(header + IP_CHECKSUM_P);
+  ENC28J60_WriteBuffer(2, field);
+  /* UDP length is in the pseudo header and in the UDP header. */
+  len = UDP_HEADER_LEN + stream->len;
+  ck = checksum_add_u16(stream->header_sum, len);
+  ck = checksum_add_u16(ck, len);
+  ck = checksum_add_u16(ck, stream->sum) ^ 0xffff;
+  if (ck == 0) {
+    /* Zero means no checksum. */
+    ck = 0xffff;
+  }
+  field[0] = len >> 8;
+  field[1] = len & 0xff;
+  field[2] = ck >> 8;
+  field[3] = ck & 0xff;
+  ENC28J60_SetWritePointer(header + UDP_LEN_H_P);
+  ENC28J60_WriteBuffer(4, field);
+  ENC28J60_PacketTransmit(stream->slot, UDP_DATA_P + stream->len);
+  SPI_CATEGORY(category);
+  ENC28J60_Select(iface);
+}
+
+/* Same as the stream functions for the datagram in the transmit buffer,
+ * which is sent before any other packet.
+ */
+uint8_t NET_udp_begin(const uint8_t *ip, uint16_t port, uint16_t src_port) {
+  return NET_udp_stream_begin(&udp_stream,
+                              ENC28J60_TxSlot(),
+                              ip,
+                              port,
+                              src_port);
+}
+
+void NET_udp_write(const uint8_t *data, uint16_t len) {
+  NET_udp_stream_write(&udp_stream, data, len);
+}
+
+void NET_udp_send(void) {
+  NET_udp_stream_send(&udp_stream);
+}
+
+/* Send datagram in one go. Returns 0 if the MAC address of the peer is
+ * not known yet, see NET_udp_begin().
+ */
+uint8_t NET_udp_sendto(const uint8_t *ip,
+                       uint16_t port,
+                       uint16_t src_port,
+                       const uint8_t *data,
+                       uint16_t len) {
+  if (!NET_udp_begin(ip, port, src_port)) {
+    return 0;
+  }
+  NET_udp_write(data, len);
+  NET_udp_send();
+  return 1;
+}
+
+/* Send number of datagrams, each one goes out as soon as the previous
+ * one left the transmit buffer. Returns number of datagrams sent.
+ */
+uint8_t NET_udp_send_batch(const NET_UDP_DATAGRAM *datagrams, uint8_t count) {
+  uint8_t i, sent = 0;
+  for (i = 0; i < count; i++) {
+    sent += NET_udp_sendto(datagrams[i].ip,
+                           datagrams[i].port,
+                           datagrams[i].src_port,
+                           datagrams[i].data,
+                           datagrams[i].len);
+  }
+  return sent;
+}
+#endif
+
+#if NET_FEATURE_TCP_SERVER
+/* Answer SYN with SYN-ACK, creating connection in SYN_RECEIVED state.
+ *
+ * When connection table is nearly full no state is allocated, instead the
+ * initial sequence number is a SYN cookie which is validated when the final
+ * ACK of the handshake arrives.
+ */
 void NET_make_tcp_synack_from_syn(uint8_t *buf) {
+  NET_TCP_CONNECTION *connection;
+  uint16_t now = TIMER_GetSeconds();
   uint16_t ck;
+  uint32_t isn;
+  int8_t conn;
+  conn = tcp_lookup(buf, now);
+  if (conn == NET_TCP_NO_CONNECTION &&
+      tcp_free_count(now) > NET_TCP_SYNCOOKIE_FREE)
+  {
+    conn = tcp_alloc(buf, now, 0);
+  }
+  if (conn != NET_TCP_NO_CONNECTION) {
+    connection = &tcp_connections[conn];
+    /* Retransmitted SYN gets the same ISN, anything else is a new
+     * connection reusing the same port.
+     */
+    if (connection->state != TCP_STATE_SYN_RECEIVED) {
+      connection->state = TCP_STATE_SYN_RECEIVED;
+      connection->snd_nxt = tcp_next_isn() + 1;
+    }
+    connection->timestamp = now;
+    isn = connection->snd_nxt - 1;
+  } else {
+    if (syncookie_secret == 0) {
+      tcp_syncookie_seed(now);
+    }
+    isn = tcp_syncookie(buf, tcp_syncookie_time());
+  }
   make_eth(buf);
   /* Total length field in the IP header must be set:
    * 20 bytes IP + 24 bytes (20tcp + 4tcp options)
@@ -413,6 +1647,10 @@ void NET_make_tcp_synack_from_syn(uint8_t *buf) {
   make_ip(buf);
   buf[TCP_FLAG_P] = TCP_FLAGS_SYNACK_V;
   make_tcphead(buf, 1, 1, 0);
+  put_u32(&buf[TCP_SEQ_H_P], isn);
+  /* Our own window, not the one of the SYN. */
+  buf[TCP_WINDOWSIZE_H_P] = NET_TCP_WINDOW >> 8;
+  buf[TCP_WINDOWSIZE_L_P] = NET_TCP_WINDOW & 0xff;
   /* Calculate the checksum,
    * len=8 (start from ip.src) + TCP_HEADER_LEN_PLAIN + 4 (one option: mss).
   */
@@ -425,7 +1663,9 @@ void NET_make_tcp_synack_from_syn(uint8_t *buf) {
   ENC28J60_PacketSend(IP_HEADER_LEN + TCP_HEADER_LEN_PLAIN + 4 + ETH_HEADER_LEN,
                       buf);
 }
+#endif
 
+#if NET_FEATURE_TCP
 /* get a pointer to the start of tcp data in buf.
  * Returns 0 if there is no data.
  * You must call NET_init_len_info once before calling this function.
@@ -450,26 +1690,6 @@ void NET_init_len_info(uint8_t *buf) {
   }
 }
 
-/* Fill in tcp data at position pos. pos=0 means start of
- * tcp data. Returns the position at which the string after
- * this string could be filled.
- */
-uint16_t NET_fill_tcp_data_p(uint8_t *buf,
-                             uint16_t pos,
-                             const char *progmem_s) {
-  char c;
-  /* Fill in tcp data at position pos. */
-  /* With no options the data starts after the checksum + 2 more bytes
-   * (urgent ptr)
-   */
-  while ((c = *progmem_s)) {
-    buf[TCP_CHECKSUM_L_P + 3 + pos] = c;
-    pos++;
-    progmem_s++;
-  }
-  return pos;
-}
-
 /* fill in tcp data at position pos. pos=0 means start of
  * tcp data. Returns the position at which the string after
  * this string could be filled.
@@ -554,14 +1774,24 @@ void NET_make_tcp_ack_with_data(uint8_t *buf, uint16_t dlen) {
       buf);
 }
 
+uint16_t NET_tcp_get_dlength(uint8_t *buf) {
+  int dlength, hlength;
+  dlength = (buf[IP_TOTLEN_H_P] << 8) | (buf[IP_TOTLEN_L_P]);
+  dlength -= IP_HEADER_LEN;
+  hlength = (buf[TCP_HEADER_LEN_P] >> 4) * 4;  /* Generate len in bytes. */
+  dlength -= hlength;
+  if (dlength <= 0) {
+    dlength = 0;
+  }
+  return (uint16_t)dlength;
+}
+#endif
+
+#if NET_FEATURE_ARP_CLIENT
 /* New functions for web client interface. */
 void NET_make_arp_request(uint8_t *buf, uint8_t *server_ip) {
-  uint8_t i = 0;
-  while (i < 6) {
-    buf[ETH_DST_MAC + i] = 0xff;
-    buf[ETH_SRC_MAC + i] = macaddr[i];
-    i++;
-  }
+  memset(&buf[ETH_DST_MAC], 0xff, 6);
+  PUT_MY_MAC(&buf[ETH_SRC_MAC]);
 
   buf[ETH_TYPE_H_P] = ETHTYPE_ARP_H_V;
   buf[ETH_TYPE_L_P] = ETHTYPE_ARP_L_V;
@@ -581,21 +1811,16 @@ void NET_make_arp_request(uint8_t *buf, uint8_t *server_ip) {
   /* Setup protocol length to 0x04. */
   buf[ARP_PROTOCOL_SIZE_P] = ARP_PROTOCOL_SIZE_V;
   /* Setup arp destination and source mac address. */
-  for (i = 0; i < 6; i++) {
-    buf[ARP_DST_MAC_P + i] = 0x00;
-    buf[ARP_SRC_MAC_P + i] = macaddr[i];
-  }
+  memset(&buf[ARP_DST_MAC_P], 0, 6);
+  PUT_MY_MAC(&buf[ARP_SRC_MAC_P]);
   /* Setup arp destination and source ip address. */
-  for (i = 0; i < 4; i++) {
-    buf[ARP_DST_IP_P + i] = server_ip[i];
-    buf[ARP_SRC_IP_P + i] = ipaddr[i];
-  }
+  memcpy(&buf[ARP_DST_IP_P], server_ip, 4);
+  PUT_MY_IP(&buf[ARP_SRC_IP_P]);
   /* eth+arp is 42 bytes. */
   ENC28J60_PacketSend(42, buf);
 }
 
 uint8_t NET_arp_packet_is_myreply_arp(uint8_t *buf) {
-  uint8_t i;
   /* If packet type is not arp packet exit from function. */
   if (buf[ETH_TYPE_H_P] != ETHTYPE_ARP_H_V ||
       buf[ETH_TYPE_L_P] != ETHTYPE_ARP_L_V)
@@ -609,14 +1834,12 @@ uint8_t NET_arp_packet_is_myreply_arp(uint8_t *buf) {
     return 0;
   }
   /* If destination ip address in arp packet not match with avr ip address. */
-  for (i = 0; i < 4; i++) {
-    if (buf[ETH_ARP_DST_IP_P + i] != ipaddr[i]) {
-      return 0;
-    }
-  }
-  return 1;
+  return IS_MY_IP(&buf[ETH_ARP_DST_IP_P]);
 }
 
+#endif
+
+#if NET_FEATURE_TCP_CLIENT
 /* Make a tcp header. */
 void NET_tcp_client_send_packet(uint8_t *buf,
                                 uint16_t dest_port,
@@ -687,8 +1910,8 @@ void NET_tcp_client_send_packet(uint8_t *buf,
   /* Set up flags. */
   buf[TCP_FLAG_P] = flags;
   /* setup maximum windows size. */
-  buf[TCP_WINDOWSIZE_H_P] = ((600 - IP_HEADER_LEN - ETH_HEADER_LEN) >> 8) & 0xff;
-  buf[TCP_WINDOWSIZE_L_P] = (600 - IP_HEADER_LEN - ETH_HEADER_LEN) & 0xff;
+  buf[TCP_WINDOWSIZE_H_P] = (NET_TCP_WINDOW >> 8) & 0xff;
+  buf[TCP_WINDOWSIZE_L_P] = NET_TCP_WINDOW & 0xff;
   /* Setup urgend pointer (not used -> 0). */
   buf[TCP_URGENT_PTR_H_P] = 0;
   buf[TCP_URGENT_PTR_L_P] = 0;
@@ -703,15 +1926,4 @@ void NET_tcp_client_send_packet(uint8_t *buf,
       IP_HEADER_LEN + TCP_HEADER_LEN_PLAIN + dlength + ETH_HEADER_LEN,
       buf);
 }
-
-uint16_t NET_tcp_get_dlength(uint8_t *buf) {
-  int dlength, hlength;
-  dlength = (buf[IP_TOTLEN_H_P] << 8) | (buf[IP_TOTLEN_L_P]);
-  dlength -= IP_HEADER_LEN;
-  hlength = (buf[TCP_HEADER_LEN_P] >> 4) * 4;  /* Generate len in bytes. */
-  dlength -= hlength;
-  if (dlength <= 0) {
-    dlength = 0;
-  }
-  return (uint16_t)dlength;
-}
+#endif
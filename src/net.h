@@ -34,6 +34,8 @@
 
 #include <stdint.h>
 
+#include "net_profile.h"
+
 /* Notation: _P = position of a field
  *           _V = value of a field
  */
@@ -131,6 +133,7 @@
 #define ICMP_TYPE_ECHOREQUEST_V 8
 #define ICMP_TYPE_P 0x22
 #define ICMP_CHECKSUM_P 0x24
+#define ICMP_DATA_P 0x2a
 
 /* ******* UDP ******* */
 #define UDP_HEADER_LEN          8
@@ -144,6 +147,39 @@
 #define UDP_CHECKSUM_L_P        0x29
 #define UDP_DATA_P              0x2a
 
+/* Largest datagram payload which fits into a frame of MAX_FRAMELEN,
+ * which counts the 4 bytes of CRC as well.
+ */
+#define NET_UDP_MAX_DATA        (MAX_FRAMELEN - 4 - UDP_DATA_P)
+
+/* Number of peers we remember the MAC address of. */
+#ifndef NET_ARP_CACHE_ENTRIES
+#  define NET_ARP_CACHE_ENTRIES   2
+#endif
+
+/* Datagram being written to the ENC28J60 buffer memory. */
+typedef struct {
+  /* Slot in the memory of the controller selected when the datagram was
+   * started with NET_udp_stream_begin().
+   */
+  uint8_t iface;
+  uint16_t slot;
+  uint16_t len;
+  /* Partial checksums of the data and of the headers without lengths. */
+  uint16_t sum;
+  uint16_t ip_sum;
+  uint16_t header_sum;
+} NET_UDP_STREAM;
+
+/* Datagram for NET_udp_send_batch(). */
+typedef struct {
+  const uint8_t *ip;
+  uint16_t port;
+  uint16_t src_port;
+  const uint8_t *data;
+  uint16_t len;
+} NET_UDP_DATAGRAM;
+
 /* ******* TCP ******* */
 /*  plain len without the options. */
 #define TCP_HEADER_LEN_PLAIN 20
@@ -183,30 +219,168 @@
 #define TCP_OPTIONS_P           0x36
 #define TCP_DATA_P              0x36
 
-void NET_init(uint8_t *mac_addr, uint8_t *ip_addr, uint8_t port);
+/* Maximum number of TCP connections the stack keeps state for. */
+#ifndef NET_TCP_MAX_CONNECTIONS
+#  define NET_TCP_MAX_CONNECTIONS 4
+#endif
+/* Once the number of free connection entries drops to this value the
+ * handshake is done statelessly using SYN cookies.
+ */
+#ifndef NET_TCP_SYNCOOKIE_FREE
+#  define NET_TCP_SYNCOOKIE_FREE  1
+#endif
+/* Idle time in seconds after which connection entries are reused. */
+#define NET_TCP_SYN_TIMEOUT     5
+#define NET_TCP_TIMEOUT         30
+/* SYN cookie timestamp granularity, 64 seconds. */
+#define NET_TCP_SYNCOOKIE_SHIFT 6
+
+#define NET_TCP_NO_CONNECTION   (-1)
+
+/* Maximum number of services accepting TCP connections. */
+#ifndef NET_TCP_MAX_LISTENERS
+#  define NET_TCP_MAX_LISTENERS   3
+#endif
+
+typedef uint8_t (*NET_TCP_ACCEPT)(int8_t conn);
+typedef void (*NET_TCP_RECEIVE)(int8_t conn, uint8_t *buf);
+
+/* Receive window we announce. */
+#define NET_TCP_WINDOW          (600 - IP_HEADER_LEN - ETH_HEADER_LEN)
+
+/* ******* Static pages ******* */
+/* Pages are complete HTTP responses generated by tools/gen_pages.py. */
+#define NET_PAGE_SEGMENT_STATIC 0  /* Data stored in program memory. */
+#define NET_PAGE_SEGMENT_FIELD  1  /* String given at runtime. */
+#define NET_PAGE_SEGMENT_LENGTH 2  /* Decimal Content-Length of the body. */
+
+typedef struct {
+  uint8_t type;
+  /* Length of static data or index of the field. */
+  uint16_t len;
+  /* Partial checksum of static data as if it started at even offset. */
+  uint16_t sum;
+  const uint8_t *data;
+} NET_PAGE_SEGMENT;
+
+typedef struct NET_PAGE {
+  const NET_PAGE_SEGMENT *segments;
+  uint8_t num_segments;
+  /* The first segments which make the response header. */
+  uint8_t header_segments;
+  /* Length of the body without fields. */
+  uint16_t body_len;
+  /* Same response with gzip encoded body, or 0. */
+  const struct NET_PAGE *gzip;
+  /* Value of the ETag header of the response. */
+  uint32_t etag;
+} NET_PAGE;
+
+/* Number of rendered pages kept in the ENC28J60 buffer memory. */
+#ifndef NET_PAGE_CACHE_ENTRIES
+#  define NET_PAGE_CACHE_ENTRIES  4
+#endif
+/* The cache takes the ENC28J60 buffer memory nobody else has allocated. */
+
+/* ******* Dispatch ******* */
+#define NET_PROTO_NONE  0
+#define NET_PROTO_ARP   1
+#define NET_PROTO_ICMP  2
+#define NET_PROTO_UDP   3
+#define NET_PROTO_TCP   4
+
+/* Maximum number of registered packet handlers. */
+#ifndef NET_MAX_HANDLERS
+#  define NET_MAX_HANDLERS  6
+#endif
+
+typedef void (*NET_HANDLER)(uint8_t *buf, uint16_t len);
+
+void NET_init(uint8_t *mac_addr, uint8_t *ip_addr);
+
+uint8_t NET_classify(uint8_t *buf, uint16_t len, uint16_t *port);
+uint8_t NET_register_handler(uint8_t proto,
+                             uint16_t port,
+                             NET_HANDLER handler);
+uint8_t NET_dispatch(uint8_t *buf, uint16_t len);
+void NET_handle_arp(uint8_t *buf, uint16_t len);
+#if NET_FEATURE_ICMP
+void NET_handle_icmp(uint8_t *buf, uint16_t len);
+#endif
 
 uint8_t NET_eth_type_is_arp_and_my_ip(uint8_t *buf, uint16_t len);
 uint8_t NET_eth_type_is_ip_and_my_ip(uint8_t *buf, uint16_t len);
 void NET_make_arp_answer_from_request(uint8_t *buf);
+#if NET_FEATURE_ICMP
 void NET_make_echo_reply_from_request(uint8_t *buf, uint16_t len);
+#endif
+
+#if NET_FEATURE_UDP
 void NET_make_udp_reply_from_request(uint8_t *buf,
-                                     char *data,
-                                     uint8_t datalen,
+                                     const char *data,
+                                     uint16_t datalen,
                                      uint16_t port);
+uint8_t NET_udp_bind(uint16_t port, NET_HANDLER receive);
+uint16_t NET_udp_fetch(uint8_t *buf, uint16_t size);
+uint8_t NET_udp_stream_begin(NET_UDP_STREAM *stream,
+                             uint16_t slot,
+                             const uint8_t *ip,
+                             uint16_t port,
+                             uint16_t src_port);
+void NET_udp_stream_reset(NET_UDP_STREAM *stream);
+void NET_udp_stream_write(NET_UDP_STREAM *stream,
+                          const uint8_t *data,
+                          uint16_t len);
+void NET_udp_stream_send(NET_UDP_STREAM *stream);
+uint8_t NET_udp_begin(const uint8_t *ip, uint16_t port, uint16_t src_port);
+void NET_udp_write(const uint8_t *data, uint16_t len);
+void NET_udp_send(void);
+uint8_t NET_udp_sendto(const uint8_t *ip,
+                       uint16_t port,
+                       uint16_t src_port,
+                       const uint8_t *data,
+                       uint16_t len);
+uint8_t NET_udp_send_batch(const NET_UDP_DATAGRAM *datagrams, uint8_t count);
+#endif
 
+#if NET_FEATURE_TCP_SERVER
 void NET_make_tcp_synack_from_syn(uint8_t *buf);
+int8_t NET_tcp_get_connection(uint8_t *buf);
+void NET_tcp_close(int8_t conn);
+uint8_t NET_tcp_is_established(int8_t conn);
+uint16_t NET_tcp_unacked(int8_t conn);
+void NET_tcp_rewind(int8_t conn);
+uint8_t NET_tcp_listen(uint16_t port,
+                       uint8_t max_connections,
+                       NET_TCP_ACCEPT accept,
+                       NET_TCP_RECEIVE receive);
+uint16_t NET_tcp_fetch(uint8_t *buf, uint16_t size);
+void NET_tcp_send(int8_t conn, uint8_t *buf, uint8_t flags, uint16_t dlen);
+void NET_tcp_send_page(int8_t conn,
+                       uint8_t *buf,
+                       const NET_PAGE *page,
+                       const char **fields,
+                       uint8_t header_only);
+void NET_page_cache_flush(void);
+#endif
+
+#if NET_FEATURE_TCP
 void NET_init_len_info(uint8_t *buf);
 uint16_t NET_get_tcp_data_pointer(void);
-uint16_t NET_fill_tcp_data_p(uint8_t *buf,
-                             uint16_t pos,
-                             const char *progmem_s);
 uint16_t NET_fill_tcp_data(uint8_t *buf,
                            uint16_t pos,
                            const char *s);
 void NET_make_tcp_ack_from_any(uint8_t *buf);
 void NET_make_tcp_ack_with_data(uint8_t *buf, uint16_t len);
+uint16_t NET_tcp_get_dlength(uint8_t *buf);
+#endif
+
+#if NET_FEATURE_ARP_CLIENT
 void NET_make_arp_request(uint8_t *buf, uint8_t *server_ip);
 uint8_t NET_arp_packet_is_myreply_arp(uint8_t *buf);
+#endif
+
+#if NET_FEATURE_TCP_CLIENT
 void NET_tcp_client_send_packet(uint8_t *buf,
                                 uint16_t dest_port,
                                 uint16_t src_port,
@@ -217,6 +391,6 @@ void NET_tcp_client_send_packet(uint8_t *buf,
                                 uint16_t dlength,
                                 uint8_t *dest_mac,
                                 uint8_t *dest_ip);
-uint16_t NET_tcp_get_dlength(uint8_t *buf);
+#endif
 
 #endif  /* __NET_H__ */
@@ -0,0 +1,122 @@
+/* Copyright (C) 2015 Sergey Sharybin <sergey.vfx@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#ifndef __NET_PROFILE_H__
+#define __NET_PROFILE_H__
+
+#include "system_config.h"
+
+/* Build-time feature profiles of the stack.
+ *
+ * A profile selects which parts of the stack are compiled in and sizes
+ * their static state, the packet buffer of the application is sized by
+ * the enabled features in app_network.c. XC8 already drops functions
+ * nobody calls, but everything reachable from NET_dispatch() and all the
+ * tables are kept, so parts the firmware does not use are to be compiled
+ * out here.
+ *
+ * Select a profile with NET_PROFILE in system_config.h or on the command
+ * line. Single NET_FEATURE_* and sizes could still be overridden the same
+ * way. tools/footprint.py builds every profile and reports its size.
+ */
+
+#define NET_PROFILE_FULL        0  /* Everything, the default. */
+#define NET_PROFILE_TCP_SERVER  1  /* Web server only: TCP server and ICMP. */
+#define NET_PROFILE_UDP         2  /* UDP services, ICMP and ARP requests. */
+
+#ifndef NET_PROFILE
+#  define NET_PROFILE NET_PROFILE_FULL
+#endif
+
+#if NET_PROFILE == NET_PROFILE_FULL
+#  ifndef NET_FEATURE_TCP_SERVER
+#    define NET_FEATURE_TCP_SERVER  1
+#  endif
+#  ifndef NET_FEATURE_TCP_CLIENT
+#    define NET_FEATURE_TCP_CLIENT  1
+#  endif
+#  ifndef NET_FEATURE_UDP
+#    define NET_FEATURE_UDP         1
+#  endif
+#  ifndef NET_FEATURE_ICMP
+#    define NET_FEATURE_ICMP        1
+#  endif
+#  ifndef NET_FEATURE_ARP_CLIENT
+#    define NET_FEATURE_ARP_CLIENT  1
+#  endif
+#elif NET_PROFILE == NET_PROFILE_TCP_SERVER
+#  ifndef NET_FEATURE_TCP_SERVER
+#    define NET_FEATURE_TCP_SERVER  1
+#  endif
+#  ifndef NET_FEATURE_TCP_CLIENT
+#    define NET_FEATURE_TCP_CLIENT  0
+#  endif
+#  ifndef NET_FEATURE_UDP
+#    define NET_FEATURE_UDP         0
+#  endif
+#  ifndef NET_FEATURE_ICMP
+#    define NET_FEATURE_ICMP        1
+#  endif
+#  ifndef NET_FEATURE_ARP_CLIENT
+#    define NET_FEATURE_ARP_CLIENT  0
+#  endif
+/* ARP and ICMP handlers only. */
+#  ifndef NET_MAX_HANDLERS
+#    define NET_MAX_HANDLERS        2
+#  endif
+/* The web server is the only listener. A connection is either an event
+ * stream subscriber or a request which is answered with a single segment,
+ * so one connection above SSE_MAX_SUBSCRIBERS keeps the pages served.
+ */
+#  ifndef NET_TCP_MAX_LISTENERS
+#    define NET_TCP_MAX_LISTENERS   1
+#  endif
+#  ifndef NET_TCP_MAX_CONNECTIONS
+#    define NET_TCP_MAX_CONNECTIONS 3
+#  endif
+#elif NET_PROFILE == NET_PROFILE_UDP
+#  ifndef NET_FEATURE_TCP_SERVER
+#    define NET_FEATURE_TCP_SERVER  0
+#  endif
+#  ifndef NET_FEATURE_TCP_CLIENT
+#    define NET_FEATURE_TCP_CLIENT  0
+#  endif
+#  ifndef NET_FEATURE_UDP
+#    define NET_FEATURE_UDP         1
+#  endif
+#  ifndef NET_FEATURE_ICMP
+#    define NET_FEATURE_ICMP        1
+#  endif
+#  ifndef NET_FEATURE_ARP_CLIENT
+#    define NET_FEATURE_ARP_CLIENT  1
+#  endif
+/* Room for more peers as UDP services tend to have more of them. */
+#  ifndef NET_ARP_CACHE_ENTRIES
+#    define NET_ARP_CACHE_ENTRIES   4
+#  endif
+#else
+#  error "Unknown NET_PROFILE"
+#endif
+
+/* Helpers shared by the TCP server and client. */
+#define NET_FEATURE_TCP  (NET_FEATURE_TCP_SERVER || NET_FEATURE_TCP_CLIENT)
+
+#endif  /* __NET_PROFILE_H__ */
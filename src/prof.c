@@ -0,0 +1,90 @@
+/* Copyright (C) 2015 Sergey Sharybin <sergey.vfx@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include "prof.h"
+
+#include <string.h>
+
+#if PROF_ENABLED
+
+PROF_SECTION PROF_Sections[PROF_NUM_SECTIONS];
+uint16_t PROF_Start[PROF_NUM_SECTIONS];
+
+void PROF_Init(void) {
+  PROF_Reset();
+  /* 16 bit reads, internal instruction clock. */
+  T1CON = 0b10000001 | (PROF_PRESCALE << 4);
+}
+
+void PROF_Reset(void) {
+  uint8_t i;
+  memset(PROF_Sections, 0, sizeof(PROF_Sections));
+  for (i = 0; i < PROF_NUM_SECTIONS; i++) {
+    PROF_Sections[i].min = 0xffff;
+  }
+}
+
+void PROF_Record(uint8_t section, uint16_t ticks) {
+  PROF_SECTION *prof = &PROF_Sections[section];
+  uint16_t value = ticks;
+  uint8_t bucket = 0;
+  if (prof->count != 0xffff) {
+    prof->count++;
+    prof->sum += ticks;
+  }
+  if (ticks < prof->min) {
+    prof->min = ticks;
+  }
+  if (ticks > prof->max) {
+    prof->max = ticks;
+  }
+  while (value >>= 1) {
+    bucket++;
+  }
+  if (prof->histogram[bucket] != 0xffff) {
+    prof->histogram[bucket]++;
+  }
+}
+
+static uint8_t put_u16(uint8_t *data, uint16_t value) {
+  data[0] = value >> 8;
+  data[1] = value & 0xff;
+  return 2;
+}
+
+/* Write the section into data, which is PROF_SECTION_ENCODED_LEN bytes big.
+ * Returns length of the encoded section.
+ */
+uint8_t PROF_Encode(uint8_t section, uint8_t *data) {
+  const PROF_SECTION *prof = &PROF_Sections[section];
+  uint8_t i, len = 0;
+  len += put_u16(&data[len], prof->count);
+  len += put_u16(&data[len], prof->min);
+  len += put_u16(&data[len], prof->max);
+  len += put_u16(&data[len], prof->sum >> 16);
+  len += put_u16(&data[len], prof->sum & 0xffff);
+  for (i = 0; i < PROF_NUM_BUCKETS; i++) {
+    len += put_u16(&data[len], prof->histogram[i]);
+  }
+  return len;
+}
+
+#endif  /* PROF_ENABLED */
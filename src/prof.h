@@ -0,0 +1,104 @@
+/* Copyright (C) 2015 Sergey Sharybin <sergey.vfx@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#ifndef __PROF_H__
+#define __PROF_H__
+
+#include <stdint.h>
+
+#include "system_config.h"
+
+/* Cycle profiling of the hot sections of the stack.
+ *
+ * Timer1 runs free from the instruction clock, PROF_BEGIN() takes its
+ * value at the start of a section and PROF_END() accumulates the number of
+ * timer ticks since then: count, min, max, sum and a histogram where
+ * bucket n counts durations with the highest set bit n.
+ *
+ * A section which is left without PROF_END() is not counted, so idle polls
+ * do not skew the numbers. Durations longer than 65535 ticks wrap around,
+ * use PROF_PRESCALE for long sections.
+ *
+ * PROF_Sections could be watched in the simulator, the demo also sends it
+ * as an answer to any datagram on PROF_PORT.
+ *
+ * Disabled by default, all the macros compile to nothing then.
+ */
+#ifndef PROF_ENABLED
+#  define PROF_ENABLED  0
+#endif
+/* Timer1 prescaler, ticks are 1 << PROF_PRESCALE instruction cycles. */
+#ifndef PROF_PRESCALE
+#  define PROF_PRESCALE  0
+#endif
+
+enum {
+  PROF_RECEIVE = 0,  /* ENC28J60_PacketReceive() of a pending packet. */
+  PROF_CHECKSUM,     /* Checksum of data in the packet buffer. */
+  PROF_HEADER,       /* Filling TCP headers from the connection template. */
+  PROF_SEND,         /* ENC28J60_PacketSend(). */
+  PROF_NUM_SECTIONS
+};
+
+#define PROF_NUM_BUCKETS  16
+
+typedef struct {
+  uint16_t count;
+  uint16_t min;
+  uint16_t max;
+  /* Sum stops with the count, so sum / count is still the mean. */
+  uint32_t sum;
+  uint16_t histogram[PROF_NUM_BUCKETS];
+} PROF_SECTION;
+
+/* Encoded section: count, min, max, sum and the histogram, big endian. */
+#define PROF_SECTION_ENCODED_LEN  (10 + PROF_NUM_BUCKETS * 2)
+
+#if PROF_ENABLED
+#  include <xc.h>
+
+extern PROF_SECTION PROF_Sections[PROF_NUM_SECTIONS];
+extern uint16_t PROF_Start[PROF_NUM_SECTIONS];
+
+/* TMR1H is latched on the read of TMR1L. */
+#  define PROF_BEGIN(section) \
+  do { \
+    PROF_Start[section] = TMR1L; \
+    PROF_Start[section] |= (uint16_t)TMR1H << 8; \
+  } while (0)
+#  define PROF_END(section) \
+  do { \
+    uint16_t prof_now = TMR1L; \
+    prof_now |= (uint16_t)TMR1H << 8; \
+    PROF_Record((section), prof_now - PROF_Start[section]); \
+  } while (0)
+
+void PROF_Init(void);
+void PROF_Reset(void);
+void PROF_Record(uint8_t section, uint16_t ticks);
+uint8_t PROF_Encode(uint8_t section, uint8_t *data);
+#else
+#  define PROF_BEGIN(section)  do { } while (0)
+#  define PROF_END(section)    do { } while (0)
+#  define PROF_Init()          do { } while (0)
+#endif
+
+#endif  /* __PROF_H__ */
@@ -25,11 +25,22 @@
 
 /* TODOs:
  * - Make transmittion/sampling configurable.
- * - Enable more than single CS bit.
  */
 
+#if SPI_NUM_CS > 1
+uint8_t SPI_Cs = 0;
+#endif
+
+#if SPI_ACCOUNTING
+SPI_ACCOUNT_ENTRY SPI_Accounts[SPI_NUM_CATEGORIES];
+uint8_t SPI_Category = SPI_CAT_INIT;
+#endif
+
 void SPI_Init(void) {
   SSP_CS_TRIS = 0;
+#if SPI_NUM_CS > 1
+  SSP_CS1_TRIS = 0;
+#endif
   SSP_SDI_TRIS = 1;
   SSP_SCK_TRIS = 0;
   SSP_SDO_TRIS  = 0;
@@ -47,25 +58,44 @@ void SPI_Init(void) {
   SSPCON1bits.CKP = 0;
   SSPCON1bits.SSPEN = 1; /* Enable serial port. */
 
-  SSP_CS_IO = 1;
+  SPI_CS_RELEASE();
 }
 
 void SPI_Write(uint8_t addr, uint8_t data) {
-  SSP_CS_IO = 0;
+  SPI_ACCOUNT(SPI_Category, 2);
+  SPI_CS_ASSERT();
   SSPBUF = addr;
   while (!PIR1bits.SSPIF);
   PIR1bits.SSPIF = 0;
   SSPBUF = data;
   while (!PIR1bits.SSPIF);
   PIR1bits.SSPIF = 0;
-  SSP_CS_IO = 1;
+  SPI_CS_RELEASE();
 }
 
 uint8_t SPI_Read(uint8_t addr) {
-  SSP_CS_IO = 0;
+  SPI_ACCOUNT(SPI_Category, 1);
+  SPI_CS_ASSERT();
   SSPBUF = 0x00;
   while (!PIR1bits.SSPIF);
   PIR1bits.SSPIF = 0;
-  SSP_CS_IO = 1;
+  SPI_CS_RELEASE();
   return SSPBUF;
 }
+
+#if SPI_ACCOUNTING
+/* Write the account into data, which is SPI_ACCOUNT_ENCODED_LEN bytes big.
+ * Returns length of the encoded account.
+ */
+uint8_t SPI_EncodeAccount(uint8_t category, uint8_t *data) {
+  const SPI_ACCOUNT_ENTRY *account = &SPI_Accounts[category];
+  uint8_t i;
+  for (i = 0; i < 4; i++) {
+    data[i] = account->transactions >> (24 - 8 * i);
+    data[4 + i] = account->bytes >> (24 - 8 * i);
+  }
+  data[8] = account->bank_switches >> 8;
+  data[9] = account->bank_switches & 0xff;
+  return SPI_ACCOUNT_ENCODED_LEN;
+}
+#endif
@@ -24,6 +24,107 @@
 
 #include <stdint.h>
 
+#include "system_config.h"
+
+/* Chip select lines in use, one per ENC28J60, see chip_configuration.h. */
+#ifdef ENC28J60_NUM_INTERFACES
+#  define SPI_NUM_CS  ENC28J60_NUM_INTERFACES
+#else
+#  define SPI_NUM_CS  1
+#endif
+
+#if SPI_NUM_CS > 2
+#  error "Only two chip select lines are mapped"
+#endif
+
+/* Transactions are framed with SPI_CS_ASSERT() and SPI_CS_RELEASE(), which
+ * drive the line picked with SPI_Select(). They expand to the pins from
+ * chip_configuration.h.
+ */
+#if SPI_NUM_CS > 1
+extern uint8_t SPI_Cs;
+#  define SPI_Select(cs)  (SPI_Cs = (cs))
+#  define SPI_CS_ASSERT() \
+  do { \
+    if (SPI_Cs) { \
+      SSP_CS1_IO = 0; \
+    } else { \
+      SSP_CS_IO = 0; \
+    } \
+  } while (0)
+#  define SPI_CS_RELEASE() \
+  do { \
+    SSP_CS_IO = 1; \
+    SSP_CS1_IO = 1; \
+  } while (0)
+#else
+#  define SPI_Select(cs)    ((void)(cs))
+#  define SPI_CS_ASSERT()   (SSP_CS_IO = 0)
+#  define SPI_CS_RELEASE()  (SSP_CS_IO = 1)
+#endif
+
+/* Accounting of the SPI traffic.
+ *
+ * Every transaction, its bytes and every ENC28J60 bank switch are counted
+ * for the category the driver is working on. Register accesses and buffer
+ * memory writes go to the category set with SPI_CATEGORY() by the function
+ * which does them, buffer memory reads always go to the receive payload.
+ *
+ * Like the interface selection, a function which sets the category puts
+ * back the one of its caller before it returns, so helpers do not leave
+ * their category behind.
+ *
+ * Counters wrap around, readers are to take differences of snapshots.
+ * SPI_Accounts could be watched in the simulator, the demo also sends it as
+ * an answer to any datagram on SPI_ACCOUNTING_PORT.
+ *
+ * Disabled by default, all the macros compile to nothing then.
+ */
+#ifndef SPI_ACCOUNTING
+#  define SPI_ACCOUNTING  0
+#endif
+
+enum {
+  SPI_CAT_RX_META = 0,  /* Receive pointers, packet count and status. */
+  SPI_CAT_RX_PAYLOAD,   /* Frame data read from the buffer memory. */
+  SPI_CAT_TX_SETUP,     /* Write pointer, transmit start and DMA. */
+  SPI_CAT_TX_PAYLOAD,   /* Frame data written to the buffer memory. */
+  SPI_CAT_TX_HEADER,    /* Headers and checksums written in place. */
+  SPI_CAT_PHY,
+  SPI_CAT_INIT,         /* Reset, configuration and identification. */
+  SPI_NUM_CATEGORIES
+};
+
+typedef struct {
+  uint32_t transactions;
+  uint32_t bytes;
+  uint16_t bank_switches;
+} SPI_ACCOUNT_ENTRY;
+
+/* Encoded account: transactions, bytes and bank switches, big endian. */
+#define SPI_ACCOUNT_ENCODED_LEN  10
+
+#if SPI_ACCOUNTING
+extern SPI_ACCOUNT_ENTRY SPI_Accounts[SPI_NUM_CATEGORIES];
+extern uint8_t SPI_Category;
+#  define SPI_CATEGORY(category)  (SPI_Category = (category))
+#  define SPI_CATEGORY_SELECTED()  SPI_Category
+#  define SPI_ACCOUNT(category, num_bytes) \
+  do { \
+    SPI_Accounts[category].transactions++; \
+    SPI_Accounts[category].bytes += (num_bytes); \
+  } while (0)
+#  define SPI_ACCOUNT_BANK_SWITCH() \
+  (SPI_Accounts[SPI_Category].bank_switches++)
+
+uint8_t SPI_EncodeAccount(uint8_t category, uint8_t *data);
+#else
+#  define SPI_CATEGORY(category)           ((void)(category))
+#  define SPI_CATEGORY_SELECTED()          0
+#  define SPI_ACCOUNT(category, num_bytes)  ((void)0)
+#  define SPI_ACCOUNT_BANK_SWITCH()        ((void)0)
+#endif
+
 void SPI_Init(void);
 void SPI_Write(uint8_t addr, uint8_t data);
 uint8_t SPI_Read(uint8_t addr);
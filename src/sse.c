@@ -0,0 +1,191 @@
+/* Copyright (C) 2015 Sergey Sharybin <sergey.vfx@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include "sse.h"
+#include "net.h"
+#include "timer.h"
+
+#include <string.h>
+
+/* Events are streamed over connections of the TCP server. */
+#if NET_FEATURE_TCP_SERVER
+
+#if SSE_KEEPALIVE >= NET_TCP_TIMEOUT
+#  error "Keepalive is to be sent before the connection times out"
+#endif
+
+static const char sse_header[] =
+    "HTTP/1.0 200 OK\r\n"
+    "Content-Type: text/event-stream\r\n"
+    "Cache-Control: no-cache\r\n\r\n";
+
+typedef struct {
+  /* NET_TCP_NO_CONNECTION if the entry is free. */
+  int8_t conn;
+  /* State changed since the last event. */
+  uint8_t pending;
+  /* The response header is not acknowledged yet. */
+  uint8_t header;
+  uint8_t retries;
+  uint16_t sent_millis;
+  uint16_t sent_seconds;
+  /* The last segment sent after the header: "data: ...\n\n". */
+  char data[6 + SSE_MAX_EVENT + 3];
+} SSE_SUBSCRIBER;
+
+static SSE_SUBSCRIBER subscribers[SSE_MAX_SUBSCRIBERS];
+static SSE_FORMAT sse_format;
+
+void SSE_Init(SSE_FORMAT format) {
+  uint8_t i;
+  sse_format = format;
+  for (i = 0; i < SSE_MAX_SUBSCRIBERS; i++) {
+    subscribers[i].conn = NET_TCP_NO_CONNECTION;
+  }
+}
+
+/* Send the last segment of the subscriber, again if it was sent already. */
+static void sse_send(SSE_SUBSCRIBER *subscriber, uint8_t *buf) {
+  uint16_t len;
+  if (subscriber->header) {
+    len = NET_fill_tcp_data(buf, 0, sse_header);
+  } else {
+    len = NET_fill_tcp_data(buf, 0, subscriber->data);
+  }
+  NET_tcp_send(subscriber->conn, buf, TCP_FLAG_ACK_V | TCP_FLAG_PUSH_V, len);
+  subscriber->sent_millis = TIMER_GetMillis();
+  subscriber->sent_seconds = TIMER_GetSeconds();
+}
+
+/* Answer request of the connection with the event stream.
+ * Returns 0 if there are too many subscribers already.
+ */
+uint8_t SSE_Subscribe(int8_t conn, uint8_t *buf) {
+  SSE_SUBSCRIBER *subscriber = 0;
+  uint8_t i;
+  for (i = 0; i < SSE_MAX_SUBSCRIBERS; i++) {
+    if (subscribers[i].conn == conn) {
+      subscriber = &subscribers[i];
+      break;
+    }
+    if (subscribers[i].conn == NET_TCP_NO_CONNECTION && subscriber == 0) {
+      subscriber = &subscribers[i];
+    }
+  }
+  if (subscriber == 0) {
+    return 0;
+  }
+  subscriber->conn = conn;
+  subscriber->header = 1;
+  /* Current state goes right after the header. */
+  subscriber->pending = 1;
+  subscriber->retries = 0;
+  sse_send(subscriber, buf);
+  return 1;
+}
+
+/* Answer HEAD request of the connection with the header of the stream
+ * alone, closing the connection.
+ */
+void SSE_Head(int8_t conn, uint8_t *buf) {
+  NET_tcp_send(conn,
+               buf,
+               TCP_FLAG_ACK_V | TCP_FLAG_PUSH_V | TCP_FLAG_FIN_V,
+               NET_fill_tcp_data(buf, 0, sse_header));
+}
+
+/* Must be called when the connection is reused for something else. */
+void SSE_Unsubscribe(int8_t conn) {
+  uint8_t i;
+  for (i = 0; i < SSE_MAX_SUBSCRIBERS; i++) {
+    if (subscribers[i].conn == conn) {
+      subscribers[i].conn = NET_TCP_NO_CONNECTION;
+    }
+  }
+}
+
+/* State has changed, event is sent to every subscriber. */
+void SSE_Changed(void) {
+  uint8_t i;
+  for (i = 0; i < SSE_MAX_SUBSCRIBERS; i++) {
+    subscribers[i].pending = 1;
+  }
+}
+
+static void sse_event(SSE_SUBSCRIBER *subscriber) {
+  uint8_t len;
+  memcpy(subscriber->data, "data: ", 6);
+  len = 6 + sse_format(&subscriber->data[6]);
+  subscriber->data[len++] = '\n';
+  subscriber->data[len++] = '\n';
+  subscriber->data[len] = '\0';
+  subscriber->pending = 0;
+}
+
+/* Must be called from the main loop, buf is used to build segments. */
+void SSE_Tasks(uint8_t *buf) {
+  SSE_SUBSCRIBER *subscriber;
+  uint16_t millis = TIMER_GetMillis();
+  uint16_t seconds = TIMER_GetSeconds();
+  uint8_t i;
+  for (i = 0; i < SSE_MAX_SUBSCRIBERS; i++) {
+    subscriber = &subscribers[i];
+    if (subscriber->conn == NET_TCP_NO_CONNECTION) {
+      continue;
+    }
+    if (!NET_tcp_is_established(subscriber->conn)) {
+      subscriber->conn = NET_TCP_NO_CONNECTION;
+      continue;
+    }
+    if (NET_tcp_unacked(subscriber->conn) != 0) {
+      if ((uint16_t)(millis - subscriber->sent_millis) < SSE_RETRANSMIT) {
+        continue;
+      }
+      if (++subscriber->retries > SSE_MAX_RETRIES) {
+        NET_tcp_send(subscriber->conn, buf, TCP_FLAG_RST_V | TCP_FLAG_ACK_V, 0);
+        NET_tcp_close(subscriber->conn);
+        subscriber->conn = NET_TCP_NO_CONNECTION;
+        continue;
+      }
+      /* Exactly the same bytes go again, the other side might have got
+       * them already and only the acknowledgement was lost.
+       */
+      NET_tcp_rewind(subscriber->conn);
+      sse_send(subscriber, buf);
+      continue;
+    }
+    subscriber->header = 0;
+    subscriber->retries = 0;
+    if (subscriber->pending &&
+        (uint16_t)(millis - subscriber->sent_millis) >= SSE_HOLDOFF)
+    {
+      sse_event(subscriber);
+      sse_send(subscriber, buf);
+    } else if ((uint16_t)(seconds - subscriber->sent_seconds) >=
+               SSE_KEEPALIVE)
+    {
+      strcpy(subscriber->data, ":\n");
+      sse_send(subscriber, buf);
+    }
+  }
+}
+
+#endif  /* NET_FEATURE_TCP_SERVER */
@@ -0,0 +1,76 @@
+/* Copyright (C) 2015 Sergey Sharybin <sergey.vfx@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#ifndef __SSE_H__
+#define __SSE_H__
+
+#include <stdint.h>
+
+/* Server-Sent Events stream of the web server.
+ *
+ * Subscribers are connections which asked for the event stream, they stay
+ * open and an event with the current state is pushed whenever it changes.
+ * Changes which happen while the previous event is not acknowledged yet,
+ * or within SSE_HOLDOFF milliseconds from it, end up in a single event.
+ *
+ * There is no retransmission in the stack, so the last segment of every
+ * subscriber is kept and sent again until it is acknowledged.
+ */
+
+#ifndef SSE_MAX_SUBSCRIBERS
+#  define SSE_MAX_SUBSCRIBERS  2
+#endif
+/* Maximum length of the event data. */
+#ifndef SSE_MAX_EVENT
+#  define SSE_MAX_EVENT        32
+#endif
+/* Minimal interval between events, in milliseconds. */
+#ifndef SSE_HOLDOFF
+#  define SSE_HOLDOFF          100
+#endif
+/* Time to wait for acknowledgement before sending again, in milliseconds. */
+#ifndef SSE_RETRANSMIT
+#  define SSE_RETRANSMIT       500
+#endif
+/* Subscriber is dropped after that many unacknowledged retransmissions. */
+#ifndef SSE_MAX_RETRIES
+#  define SSE_MAX_RETRIES      4
+#endif
+/* Idle streams get a comment line every that many seconds, so neither the
+ * connection times out nor dead subscribers stay forever.
+ */
+#ifndef SSE_KEEPALIVE
+#  define SSE_KEEPALIVE        15
+#endif
+
+/* Write data of the event with the current state into data, which is
+ * SSE_MAX_EVENT + 1 bytes big. Returns length of the data.
+ */
+typedef uint8_t (*SSE_FORMAT)(char *data);
+
+void SSE_Init(SSE_FORMAT format);
+uint8_t SSE_Subscribe(int8_t conn, uint8_t *buf);
+void SSE_Head(int8_t conn, uint8_t *buf);
+void SSE_Unsubscribe(int8_t conn);
+void SSE_Changed(void);
+void SSE_Tasks(uint8_t *buf);
+
+#endif  /* __SSE_H__ */
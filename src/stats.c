@@ -0,0 +1,106 @@
+/* Copyright (C) 2015 Sergey Sharybin <sergey.vfx@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include "stats.h"
+
+#include <string.h>
+
+#if STATS_ENABLED
+
+STATS_COUNTERS STATS_Counters;
+
+/* Names in the JSON snapshot, at most 5 characters long. */
+static const char *const names[STATS_NUM_COUNTERS] = {
+  "rx", "rxerr", "drop", "trunc", "arp",
+  "echo", "acc", "rst", "tx", "txerr",
+};
+
+static uint16_t stats_get(uint8_t i) {
+  switch (i) {
+    case 0: return STATS_Counters.rx_frames;
+    case 1: return STATS_Counters.rx_errors;
+    case 2: return STATS_Counters.rx_dropped;
+    case 3: return STATS_Counters.rx_truncated;
+    case 4: return STATS_Counters.arp_replies;
+    case 5: return STATS_Counters.echo_replies;
+    case 6: return STATS_Counters.tcp_accepted;
+    case 7: return STATS_Counters.tcp_resets;
+    case 8: return STATS_Counters.tx_frames;
+    case 9: return STATS_Counters.tx_errors;
+  }
+  return 0;
+}
+
+void STATS_Reset(void) {
+  memset(&STATS_Counters, 0, sizeof(STATS_Counters));
+}
+
+/* Write the snapshot into data, which is STATS_ENCODED_LEN bytes big.
+ * Returns length of the snapshot.
+ */
+uint8_t STATS_Encode(uint8_t *data) {
+  uint16_t value;
+  uint8_t i;
+  data[0] = STATS_VERSION;
+  data[1] = STATS_NUM_COUNTERS;
+  for (i = 0; i < STATS_NUM_COUNTERS; i++) {
+    value = stats_get(i);
+    data[2 + i * 2] = value >> 8;
+    data[3 + i * 2] = value & 0xff;
+  }
+  return STATS_ENCODED_LEN;
+}
+
+/* Write the snapshot as a JSON object into str, which is
+ * STATS_JSON_MAX_LEN + 1 bytes big. Returns length of the string.
+ */
+uint8_t STATS_Json(char *str) {
+  const char *name;
+  char digits[5];
+  uint16_t value;
+  uint8_t i, j, len = 0;
+  str[len++] = '{';
+  for (i = 0; i < STATS_NUM_COUNTERS; i++) {
+    if (i != 0) {
+      str[len++] = ',';
+    }
+    str[len++] = '"';
+    for (name = names[i]; *name != '\0'; name++) {
+      str[len++] = *name;
+    }
+    str[len++] = '"';
+    str[len++] = ':';
+    value = stats_get(i);
+    j = 0;
+    do {
+      digits[j++] = '0' + value % 10;
+      value /= 10;
+    } while (value);
+    while (j) {
+      str[len++] = digits[--j];
+    }
+  }
+  str[len++] = '}';
+  str[len] = '\0';
+  return len;
+}
+
+#endif  /* STATS_ENABLED */
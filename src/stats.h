@@ -0,0 +1,91 @@
+/* Copyright (C) 2015 Sergey Sharybin <sergey.vfx@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#ifndef __STATS_H__
+#define __STATS_H__
+
+#include <stdint.h>
+
+#include "system_config.h"
+
+/* Counters of what the stack is doing.
+ *
+ * Counters saturate instead of wrapping around, so a device being flooded
+ * shows up as a stuck maximum. Frequent events have 16 bit counters, errors
+ * which should be rare have 8 bit ones. Incrementing a counter is inlined,
+ * there are no calls on the hot paths.
+ *
+ * The snapshot is sent as an answer to any datagram on STATS_PORT and is
+ * also served as JSON at /stats.
+ */
+
+/* Set to 0 to leave the counters out, STATS_INC() is a no-op then. */
+#ifndef STATS_ENABLED
+#  define STATS_ENABLED  1
+#endif
+
+typedef struct {
+  /* Valid frames taken from the controller. */
+  uint16_t rx_frames;
+  /* Frames received with CRC or symbol errors. */
+  uint8_t rx_errors;
+  /* Frames which are not for us or nobody is interested in. */
+  uint16_t rx_dropped;
+  /* Datagrams and segments cut to the size of the packet buffer. */
+  uint16_t rx_truncated;
+  uint16_t arp_replies;
+  uint16_t echo_replies;
+  uint16_t tcp_accepted;
+  /* Connections reset by either side. */
+  uint16_t tcp_resets;
+  /* Frames handed to the controller for transmission. */
+  uint16_t tx_frames;
+  /* Transmit errors reported by the controller. */
+  uint8_t tx_errors;
+} STATS_COUNTERS;
+
+/* Number of counters in the snapshot. */
+#define STATS_NUM_COUNTERS  10
+/* Snapshot format: version, number of counters, then every counter as a
+ * big endian 16 bit value in the order of STATS_COUNTERS.
+ */
+#define STATS_VERSION       1
+#define STATS_ENCODED_LEN   (2 + STATS_NUM_COUNTERS * 2)
+/* Maximum length of the JSON snapshot. */
+#define STATS_JSON_MAX_LEN  (2 + STATS_NUM_COUNTERS * 14)
+
+#if STATS_ENABLED
+extern STATS_COUNTERS STATS_Counters;
+#  define STATS_INC(counter) \
+  do { \
+    if (++STATS_Counters.counter == 0) { \
+      STATS_Counters.counter--; \
+    } \
+  } while (0)
+#else
+#  define STATS_INC(counter)  do { } while (0)
+#endif
+
+void STATS_Reset(void);
+uint8_t STATS_Encode(uint8_t *data);
+uint8_t STATS_Json(char *str);
+
+#endif  /* __STATS_H__ */
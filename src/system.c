@@ -26,6 +26,8 @@
 #include "system.h"
 #include "chip_configuration.h"
 #include "app_network.h"
+#include "prof.h"
+#include "timer.h"
 
 typedef enum {
     SOFT_START_POWER_OFF,
@@ -63,7 +65,12 @@ void SYSTEM_Initialize() {
   LATE = 0b00000000;
 #endif
 
+  TIMER_Init();
+  PROF_Init();
   APP_network_init();
+
+  /* Interrupts are enabled once everything is initialized. */
+  INTCONbits.GIE = 1;
 }
 
 /* Runs system level tasks that keep the system running.
@@ -75,6 +82,7 @@ void SYSTEM_Tasks(void) {
 
 #if defined(__XC8)
 void interrupt SYS_InterruptHigh(void) {
+  TIMER_Interrupt();
 #  if defined(USB_INTERRUPT)
     USBDeviceTasks();
 #  endif
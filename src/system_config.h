@@ -22,4 +22,63 @@
 #ifndef __SYSTEM_CONFIG__
 #define __SYSTEM_CONFIG__
 
+/* Addresses of the board. */
+#define NET_MAC_ADDR0  0x54
+#define NET_MAC_ADDR1  0x55
+#define NET_MAC_ADDR2  0x58
+#define NET_MAC_ADDR3  0x10
+#define NET_MAC_ADDR4  0x00
+#define NET_MAC_ADDR5  0x24
+#define NET_IP_ADDR0   192
+#define NET_IP_ADDR1   168
+#define NET_IP_ADDR2   0
+#define NET_IP_ADDR3   4
+
+/* Define to drive a second ENC28J60 with its chip select on RA4, see
+ * enc28j60.h. The first interface takes control traffic and the second
+ * one bulk telemetry.
+ */
+/* #define ENC28J60_NUM_INTERFACES 2 */
+/* Addresses of the second interface. */
+#define NET1_MAC_ADDR0  0x54
+#define NET1_MAC_ADDR1  0x55
+#define NET1_MAC_ADDR2  0x58
+#define NET1_MAC_ADDR3  0x10
+#define NET1_MAC_ADDR4  0x00
+#define NET1_MAC_ADDR5  0x25
+#define NET1_IP_ADDR0   192
+#define NET1_IP_ADDR1   168
+#define NET1_IP_ADDR2   1
+#define NET1_IP_ADDR3   4
+
+/* Define to stream uptime and LED state samples to a telemetry collector,
+ * see telemetry.h. Samples go out on the last interface, so the collector
+ * is to be on its subnet. Nothing is sent unless the address is defined.
+ */
+/* #define TELEMETRY_COLLECTOR_ADDR0  192 */
+/* #define TELEMETRY_COLLECTOR_ADDR1  168 */
+/* #define TELEMETRY_COLLECTOR_ADDR2  0 */
+/* #define TELEMETRY_COLLECTOR_ADDR3  2 */
+/* #define TELEMETRY_COLLECTOR_PORT   5001 */
+/* Time between two samples in milliseconds. */
+/* #define TELEMETRY_SAMPLE_PERIOD    100 */
+
+/* Define to have the addresses above compiled into the stack, so address
+ * matching and header filling become constant compares and stores.
+ * Otherwise addresses are given to NET_init() at runtime and could come
+ * from anywhere.
+ */
+/* #define NET_STATIC_ADDRESS */
+
+/* Parts of the stack to build, see net_profile.h. */
+/* #define NET_PROFILE NET_PROFILE_TCP_SERVER */
+
+/* Define to time the hot sections of the stack with Timer1, see prof.h. */
+/* #define PROF_ENABLED 1 */
+
+/* Define to count SPI transactions, bytes and bank switches per kind of
+ * driver work, see spi.h.
+ */
+/* #define SPI_ACCOUNTING 1 */
+
 #endif  /* __SYSTEM_CONFIG__ */
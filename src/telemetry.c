@@ -0,0 +1,141 @@
+/* Copyright (C) 2015 Sergey Sharybin <sergey.vfx@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include "telemetry.h"
+#include "enc28j60.h"
+#include "net.h"
+#include "timer.h"
+
+#include <string.h>
+
+/* Samples are sent as UDP datagrams. */
+#if NET_FEATURE_UDP
+
+#define TELEMETRY_DATA_SIZE  (TELEMETRY_BATCH_SIZE * TELEMETRY_SAMPLE_SIZE)
+#define TELEMETRY_SLOT_SIZE  ENC28J60_TX_SLOT_SIZE(UDP_DATA_P + \
+                                                   TELEMETRY_DATA_SIZE)
+
+#if TELEMETRY_DATA_SIZE > NET_UDP_MAX_DATA
+#  error "Telemetry batch does not fit into a frame"
+#endif
+
+static uint8_t collector_ip[4];
+static uint16_t collector_port;
+static uint16_t src_port;
+/* Interface selected at TELEMETRY_Init(), the slots are in its memory. */
+static uint8_t iface;
+static NET_UDP_STREAM streams[2];
+static uint8_t active = 0;
+/* Headers are written to the slots once the collector MAC is known.
+ * Until then it is asked for once a second.
+ */
+static uint8_t ready = 0;
+static uint16_t begin_time;
+/* Time of the first sample in the active datagram. */
+static uint16_t batch_start;
+
+void TELEMETRY_Init(const uint8_t *ip, uint16_t port, uint16_t local_port) {
+  uint8_t i;
+  memcpy(collector_ip, ip, 4);
+  collector_port = port;
+  src_port = local_port;
+  iface = ENC28J60_Selected();
+  ready = 0;
+  begin_time = TIMER_GetSeconds() - 1;
+  for (i = 0; i < 2; i++) {
+    streams[i].slot = ENC28J60_MemAlloc(TELEMETRY_SLOT_SIZE);
+  }
+}
+
+/* Headers are written on the interface of the slots, the selected
+ * interface is kept.
+ */
+static uint8_t telemetry_begin(void) {
+  uint16_t now = TIMER_GetSeconds();
+  uint8_t selected, i;
+  if (now == begin_time) {
+    return 0;
+  }
+  begin_time = now;
+  selected = ENC28J60_Selected();
+  ENC28J60_Select(iface);
+  for (i = 0; i < 2; i++) {
+    if (streams[i].slot == ENC28J60_NO_MEMORY ||
+        !NET_udp_stream_begin(&streams[i],
+                              streams[i].slot,
+                              collector_ip,
+                              collector_port,
+                              src_port))
+    {
+      break;
+    }
+  }
+  ENC28J60_Select(selected);
+  if (i != 2) {
+    return 0;
+  }
+  active = 0;
+  ready = 1;
+  return 1;
+}
+
+/* Append sample of TELEMETRY_SAMPLE_SIZE bytes.
+ * Returns 0 if the sample is dropped because the collector is not
+ * reachable yet.
+ */
+uint8_t TELEMETRY_Sample(const uint8_t *sample) {
+  NET_UDP_STREAM *stream;
+  if (!ready && !telemetry_begin()) {
+    return 0;
+  }
+  stream = &streams[active];
+  if (stream->len == 0) {
+    batch_start = TIMER_GetMillis();
+  }
+  NET_udp_stream_write(stream, sample, TELEMETRY_SAMPLE_SIZE);
+  if (stream->len == TELEMETRY_DATA_SIZE) {
+    TELEMETRY_Flush();
+  }
+  return 1;
+}
+
+/* Send the samples collected so far. */
+void TELEMETRY_Flush(void) {
+  NET_UDP_STREAM *stream = &streams[active];
+  if (!ready || stream->len == 0) {
+    return;
+  }
+  NET_udp_stream_send(stream);
+  /* The other datagram was sent before this one, so it is free now. */
+  active ^= 1;
+  NET_udp_stream_reset(&streams[active]);
+}
+
+/* Must be called from the main loop to meet the deadline. */
+void TELEMETRY_Tasks(void) {
+  if (ready && streams[active].len != 0 &&
+      (uint16_t)(TIMER_GetMillis() - batch_start) >= TELEMETRY_DEADLINE)
+  {
+    TELEMETRY_Flush();
+  }
+}
+
+#endif  /* NET_FEATURE_UDP */
@@ -0,0 +1,60 @@
+/* Copyright (C) 2015 Sergey Sharybin <sergey.vfx@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#ifndef __TELEMETRY_H__
+#define __TELEMETRY_H__
+
+#include <stdint.h>
+
+/* Streaming of fixed size samples to a collector over UDP.
+ *
+ * Samples are appended straight to a datagram in the ENC28J60 buffer
+ * memory, which is sent once it is full or the oldest sample in it is
+ * TELEMETRY_DEADLINE milliseconds old. There are two such datagrams, one
+ * is filled while the other one is transmitted. Their headers are written
+ * once, so a sample costs a single SPI burst.
+ *
+ * Samples go out on the interface selected when TELEMETRY_Init() is called.
+ */
+
+/* Size of a single sample in bytes. */
+#ifndef TELEMETRY_SAMPLE_SIZE
+#  define TELEMETRY_SAMPLE_SIZE  8
+#endif
+/* Samples in a single datagram, two of them have to fit into the buffer
+ * memory next to the transmit buffer.
+ */
+#ifndef TELEMETRY_BATCH_SIZE
+#  define TELEMETRY_BATCH_SIZE   56
+#endif
+/* Maximum age of a sample before it is sent, in milliseconds. */
+#ifndef TELEMETRY_DEADLINE
+#  define TELEMETRY_DEADLINE     20
+#endif
+
+void TELEMETRY_Init(const uint8_t *ip,
+                    uint16_t port,
+                    uint16_t local_port);
+uint8_t TELEMETRY_Sample(const uint8_t *sample);
+void TELEMETRY_Flush(void);
+void TELEMETRY_Tasks(void);
+
+#endif  /* __TELEMETRY_H__ */
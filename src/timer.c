@@ -0,0 +1,81 @@
+/* Copyright (C) 2015 Sergey Sharybin <sergey.vfx@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include "timer.h"
+#include "chip_configuration.h"
+
+/* Timer0 runs from the instruction clock without prescaler. */
+#define TIMER_TICKS_PER_MS  (_XTAL_FREQ / 4 / 1000)
+#define TIMER_RELOAD        (65536 - TIMER_TICKS_PER_MS)
+
+static volatile uint16_t milliseconds = 0;
+static volatile uint16_t seconds = 0;
+static volatile uint16_t second_ms = 0;
+
+static void timer_reload(void) {
+  /* TMR0H is buffered and gets latched on the write to TMR0L. */
+  TMR0H = TIMER_RELOAD >> 8;
+  TMR0L = TIMER_RELOAD & 0xff;
+}
+
+void TIMER_Init(void) {
+  T0CON = 0b00000000;
+  T0CONbits.T08BIT = 0;  /* 16 bit mode. */
+  T0CONbits.T0CS = 0;  /* Internal instruction cycle clock. */
+  T0CONbits.PSA = 1;  /* Prescaler is not assigned. */
+  timer_reload();
+  INTCONbits.TMR0IF = 0;
+  INTCONbits.TMR0IE = 1;
+  T0CONbits.TMR0ON = 1;
+}
+
+void TIMER_Interrupt(void) {
+  if (!INTCONbits.TMR0IF) {
+    return;
+  }
+  timer_reload();
+  INTCONbits.TMR0IF = 0;
+  milliseconds++;
+  if (++second_ms == 1000) {
+    second_ms = 0;
+    seconds++;
+  }
+}
+
+/* 16 bit reads are not atomic on PIC18, so keep timer interrupt away while
+ * reading the counters.
+ */
+
+uint16_t TIMER_GetMillis(void) {
+  uint16_t result;
+  INTCONbits.TMR0IE = 0;
+  result = milliseconds;
+  INTCONbits.TMR0IE = 1;
+  return result;
+}
+
+uint16_t TIMER_GetSeconds(void) {
+  uint16_t result;
+  INTCONbits.TMR0IE = 0;
+  result = seconds;
+  INTCONbits.TMR0IE = 1;
+  return result;
+}
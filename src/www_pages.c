@@ -0,0 +1,326 @@
+/* Generated by tools/gen_pages.py from the www directory, do not edit. */
+
+#include "www_pages.h"
+
+#if NET_FEATURE_TCP_SERVER
+
+static const uint8_t page_400_0[91] = {
+  0x48, 0x54, 0x54, 0x50, 0x2f, 0x31, 0x2e, 0x30, 0x20, 0x34, 0x30, 0x30,
+  0x20, 0x42, 0x61, 0x64, 0x20, 0x52, 0x65, 0x71, 0x75, 0x65, 0x73, 0x74,
+  0x0d, 0x0a, 0x43, 0x6f, 0x6e, 0x74, 0x65, 0x6e, 0x74, 0x2d, 0x54, 0x79,
+  0x70, 0x65, 0x3a, 0x20, 0x74, 0x65, 0x78, 0x74, 0x2f, 0x68, 0x74, 0x6d,
+  0x6c, 0x0d, 0x0a, 0x45, 0x54, 0x61, 0x67, 0x3a, 0x20, 0x22, 0x38, 0x33,
+  0x63, 0x62, 0x66, 0x34, 0x38, 0x36, 0x22, 0x0d, 0x0a, 0x43, 0x6f, 0x6e,
+  0x74, 0x65, 0x6e, 0x74, 0x2d, 0x4c, 0x65, 0x6e, 0x67, 0x74, 0x68, 0x3a,
+  0x20, 0x32, 0x34, 0x0d, 0x0a, 0x0d, 0x0a,
+};
+static const uint8_t page_400_1[24] = {
+  0x3c, 0x68, 0x31, 0x3e, 0x34, 0x30, 0x30, 0x20, 0x42, 0x61, 0x64, 0x20,
+  0x52, 0x65, 0x71, 0x75, 0x65, 0x73, 0x74, 0x3c, 0x2f, 0x68, 0x31, 0x3e,
+};
+static const NET_PAGE_SEGMENT page_400_segments[2] = {
+  {NET_PAGE_SEGMENT_STATIC, 91, 0x3845, page_400_0},
+  {NET_PAGE_SEGMENT_STATIC, 24, 0x76a9, page_400_1},
+};
+const NET_PAGE page_400 = {
+  page_400_segments, 2, 1, 24, 0, 0x83cbf486UL
+};
+
+static const uint8_t page_404_0[89] = {
+  0x48, 0x54, 0x54, 0x50, 0x2f, 0x31, 0x2e, 0x30, 0x20, 0x34, 0x30, 0x34,
+  0x20, 0x4e, 0x6f, 0x74, 0x20, 0x46, 0x6f, 0x75, 0x6e, 0x64, 0x0d, 0x0a,
+  0x43, 0x6f, 0x6e, 0x74, 0x65, 0x6e, 0x74, 0x2d, 0x54, 0x79, 0x70, 0x65,
+  0x3a, 0x20, 0x74, 0x65, 0x78, 0x74, 0x2f, 0x68, 0x74, 0x6d, 0x6c, 0x0d,
+  0x0a, 0x45, 0x54, 0x61, 0x67, 0x3a, 0x20, 0x22, 0x35, 0x65, 0x66, 0x32,
+  0x65, 0x37, 0x33, 0x32, 0x22, 0x0d, 0x0a, 0x43, 0x6f, 0x6e, 0x74, 0x65,
+  0x6e, 0x74, 0x2d, 0x4c, 0x65, 0x6e, 0x67, 0x74, 0x68, 0x3a, 0x20, 0x32,
+  0x32, 0x0d, 0x0a, 0x0d, 0x0a,
+};
+static const uint8_t page_404_1[22] = {
+  0x3c, 0x68, 0x31, 0x3e, 0x34, 0x30, 0x34, 0x20, 0x4e, 0x6f, 0x74, 0x20,
+  0x46, 0x6f, 0x75, 0x6e, 0x64, 0x3c, 0x2f, 0x68, 0x31, 0x3e,
+};
+static const NET_PAGE_SEGMENT page_404_segments[2] = {
+  {NET_PAGE_SEGMENT_STATIC, 89, 0xcde8, page_404_0},
+  {NET_PAGE_SEGMENT_STATIC, 22, 0x1947, page_404_1},
+};
+const NET_PAGE page_404 = {
+  page_404_segments, 2, 1, 22, 0, 0x5ef2e732UL
+};
+
+static const uint8_t page_405_0[98] = {
+  0x48, 0x54, 0x54, 0x50, 0x2f, 0x31, 0x2e, 0x30, 0x20, 0x34, 0x30, 0x35,
+  0x20, 0x4d, 0x65, 0x74, 0x68, 0x6f, 0x64, 0x20, 0x4e, 0x6f, 0x74, 0x20,
+  0x41, 0x6c, 0x6c, 0x6f, 0x77, 0x65, 0x64, 0x0d, 0x0a, 0x43, 0x6f, 0x6e,
+  0x74, 0x65, 0x6e, 0x74, 0x2d, 0x54, 0x79, 0x70, 0x65, 0x3a, 0x20, 0x74,
+  0x65, 0x78, 0x74, 0x2f, 0x68, 0x74, 0x6d, 0x6c, 0x0d, 0x0a, 0x45, 0x54,
+  0x61, 0x67, 0x3a, 0x20, 0x22, 0x38, 0x39, 0x66, 0x62, 0x65, 0x64, 0x33,
+  0x36, 0x22, 0x0d, 0x0a, 0x43, 0x6f, 0x6e, 0x74, 0x65, 0x6e, 0x74, 0x2d,
+  0x4c, 0x65, 0x6e, 0x67, 0x74, 0x68, 0x3a, 0x20, 0x33, 0x31, 0x0d, 0x0a,
+  0x0d, 0x0a,
+};
+static const uint8_t page_405_1[31] = {
+  0x3c, 0x68, 0x31, 0x3e, 0x34, 0x30, 0x35, 0x20, 0x4d, 0x65, 0x74, 0x68,
+  0x6f, 0x64, 0x20, 0x4e, 0x6f, 0x74, 0x20, 0x41, 0x6c, 0x6c, 0x6f, 0x77,
+  0x65, 0x64, 0x3c, 0x2f, 0x68, 0x31, 0x3e,
+};
+static const NET_PAGE_SEGMENT page_405_segments[2] = {
+  {NET_PAGE_SEGMENT_STATIC, 98, 0xb689, page_405_0},
+  {NET_PAGE_SEGMENT_STATIC, 31, 0xdbd5, page_405_1},
+};
+const NET_PAGE page_405 = {
+  page_405_segments, 2, 1, 31, 0, 0x89fbed36UL
+};
+
+static const uint8_t page_503_0[99] = {
+  0x48, 0x54, 0x54, 0x50, 0x2f, 0x31, 0x2e, 0x30, 0x20, 0x35, 0x30, 0x33,
+  0x20, 0x53, 0x65, 0x72, 0x76, 0x69, 0x63, 0x65, 0x20, 0x55, 0x6e, 0x61,
+  0x76, 0x61, 0x69, 0x6c, 0x61, 0x62, 0x6c, 0x65, 0x0d, 0x0a, 0x43, 0x6f,
+  0x6e, 0x74, 0x65, 0x6e, 0x74, 0x2d, 0x54, 0x79, 0x70, 0x65, 0x3a, 0x20,
+  0x74, 0x65, 0x78, 0x74, 0x2f, 0x68, 0x74, 0x6d, 0x6c, 0x0d, 0x0a, 0x45,
+  0x54, 0x61, 0x67, 0x3a, 0x20, 0x22, 0x31, 0x39, 0x34, 0x33, 0x38, 0x66,
+  0x38, 0x63, 0x22, 0x0d, 0x0a, 0x43, 0x6f, 0x6e, 0x74, 0x65, 0x6e, 0x74,
+  0x2d, 0x4c, 0x65, 0x6e, 0x67, 0x74, 0x68, 0x3a, 0x20, 0x33, 0x32, 0x0d,
+  0x0a, 0x0d, 0x0a,
+};
+static const uint8_t page_503_1[32] = {
+  0x3c, 0x68, 0x31, 0x3e, 0x35, 0x30, 0x33, 0x20, 0x53, 0x65, 0x72, 0x76,
+  0x69, 0x63, 0x65, 0x20, 0x55, 0x6e, 0x61, 0x76, 0x61, 0x69, 0x6c, 0x61,
+  0x62, 0x6c, 0x65, 0x3c, 0x2f, 0x68, 0x31, 0x3e,
+};
+static const NET_PAGE_SEGMENT page_503_segments[2] = {
+  {NET_PAGE_SEGMENT_STATIC, 99, 0x7e1c, page_503_0},
+  {NET_PAGE_SEGMENT_STATIC, 32, 0x1755, page_503_1},
+};
+const NET_PAGE page_503 = {
+  page_503_segments, 2, 1, 32, 0, 0x19438f8cUL
+};
+
+static const uint8_t page_led_off_0[76] = {
+  0x48, 0x54, 0x54, 0x50, 0x2f, 0x31, 0x2e, 0x30, 0x20, 0x32, 0x30, 0x30,
+  0x20, 0x4f, 0x4b, 0x0d, 0x0a, 0x43, 0x6f, 0x6e, 0x74, 0x65, 0x6e, 0x74,
+  0x2d, 0x54, 0x79, 0x70, 0x65, 0x3a, 0x20, 0x74, 0x65, 0x78, 0x74, 0x2f,
+  0x68, 0x74, 0x6d, 0x6c, 0x0d, 0x0a, 0x45, 0x54, 0x61, 0x67, 0x3a, 0x20,
+  0x22, 0x31, 0x32, 0x64, 0x65, 0x65, 0x38, 0x32, 0x38, 0x22, 0x0d, 0x0a,
+  0x43, 0x6f, 0x6e, 0x74, 0x65, 0x6e, 0x74, 0x2d, 0x4c, 0x65, 0x6e, 0x67,
+  0x74, 0x68, 0x3a, 0x20,
+};
+static const uint8_t page_led_off_2[4] = {
+  0x0d, 0x0a, 0x0d, 0x0a,
+};
+static const uint8_t page_led_off_3[116] = {
+  0x3c, 0x6c, 0x69, 0x6e, 0x6b, 0x20, 0x72, 0x65, 0x6c, 0x3d, 0x73, 0x74,
+  0x79, 0x6c, 0x65, 0x73, 0x68, 0x65, 0x65, 0x74, 0x20, 0x68, 0x72, 0x65,
+  0x66, 0x3d, 0x22, 0x2f, 0x73, 0x74, 0x79, 0x6c, 0x65, 0x2e, 0x63, 0x73,
+  0x73, 0x22, 0x3e, 0x3c, 0x68, 0x31, 0x3e, 0x57, 0x65, 0x6c, 0x63, 0x6f,
+  0x6d, 0x65, 0x20, 0x74, 0x6f, 0x20, 0x45, 0x54, 0x48, 0x32, 0x38, 0x4a,
+  0x36, 0x30, 0x20, 0x44, 0x65, 0x6d, 0x6f, 0x20, 0x66, 0x6f, 0x72, 0x20,
+  0x50, 0x49, 0x43, 0x31, 0x38, 0x46, 0x34, 0x35, 0x35, 0x30, 0x3c, 0x2f,
+  0x68, 0x31, 0x3e, 0x3c, 0x68, 0x72, 0x3e, 0x3c, 0x66, 0x6f, 0x72, 0x6d,
+  0x20, 0x4d, 0x45, 0x54, 0x48, 0x4f, 0x44, 0x3d, 0x67, 0x65, 0x74, 0x20,
+  0x61, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x3d, 0x22,
+};
+static const uint8_t page_led_off_5[126] = {
+  0x22, 0x3e, 0x3c, 0x68, 0x32, 0x3e, 0x52, 0x45, 0x4d, 0x4f, 0x54, 0x45,
+  0x20, 0x4c, 0x45, 0x44, 0x20, 0x69, 0x73, 0x3c, 0x2f, 0x68, 0x32, 0x3e,
+  0x3c, 0x68, 0x31, 0x20, 0x63, 0x6c, 0x61, 0x73, 0x73, 0x3d, 0x6f, 0x66,
+  0x66, 0x3e, 0x4f, 0x46, 0x46, 0x3c, 0x2f, 0x68, 0x31, 0x3e, 0x3c, 0x69,
+  0x6e, 0x70, 0x75, 0x74, 0x20, 0x74, 0x79, 0x70, 0x65, 0x3d, 0x68, 0x69,
+  0x64, 0x64, 0x65, 0x6e, 0x20, 0x6e, 0x61, 0x6d, 0x65, 0x3d, 0x63, 0x6d,
+  0x64, 0x20, 0x76, 0x61, 0x6c, 0x75, 0x65, 0x3d, 0x32, 0x3e, 0x3c, 0x69,
+  0x6e, 0x70, 0x75, 0x74, 0x20, 0x74, 0x79, 0x70, 0x65, 0x3d, 0x73, 0x75,
+  0x62, 0x6d, 0x69, 0x74, 0x20, 0x76, 0x61, 0x6c, 0x75, 0x65, 0x3d, 0x22,
+  0x53, 0x77, 0x69, 0x74, 0x63, 0x68, 0x20, 0x6f, 0x6e, 0x22, 0x3e, 0x3c,
+  0x2f, 0x66, 0x6f, 0x72, 0x6d, 0x3e,
+};
+static const NET_PAGE_SEGMENT page_led_off_segments[6] = {
+  {NET_PAGE_SEGMENT_STATIC, 76, 0x0860, page_led_off_0},
+  {NET_PAGE_SEGMENT_LENGTH, 0, 0, 0},
+  {NET_PAGE_SEGMENT_STATIC, 4, 0x1a14, page_led_off_2},
+  {NET_PAGE_SEGMENT_STATIC, 116, 0xaf08, page_led_off_3},
+  {NET_PAGE_SEGMENT_FIELD, 0, 0, 0},
+  {NET_PAGE_SEGMENT_STATIC, 126, 0x581e, page_led_off_5},
+};
+const NET_PAGE page_led_off = {
+  page_led_off_segments, 6, 3, 242, 0, 0x12dee828UL
+};
+
+static const uint8_t page_led_on_0[76] = {
+  0x48, 0x54, 0x54, 0x50, 0x2f, 0x31, 0x2e, 0x30, 0x20, 0x32, 0x30, 0x30,
+  0x20, 0x4f, 0x4b, 0x0d, 0x0a, 0x43, 0x6f, 0x6e, 0x74, 0x65, 0x6e, 0x74,
+  0x2d, 0x54, 0x79, 0x70, 0x65, 0x3a, 0x20, 0x74, 0x65, 0x78, 0x74, 0x2f,
+  0x68, 0x74, 0x6d, 0x6c, 0x0d, 0x0a, 0x45, 0x54, 0x61, 0x67, 0x3a, 0x20,
+  0x22, 0x36, 0x65, 0x66, 0x35, 0x61, 0x33, 0x37, 0x37, 0x22, 0x0d, 0x0a,
+  0x43, 0x6f, 0x6e, 0x74, 0x65, 0x6e, 0x74, 0x2d, 0x4c, 0x65, 0x6e, 0x67,
+  0x74, 0x68, 0x3a, 0x20,
+};
+static const uint8_t page_led_on_5[125] = {
+  0x22, 0x3e, 0x3c, 0x68, 0x32, 0x3e, 0x52, 0x45, 0x4d, 0x4f, 0x54, 0x45,
+  0x20, 0x4c, 0x45, 0x44, 0x20, 0x69, 0x73, 0x3c, 0x2f, 0x68, 0x32, 0x3e,
+  0x3c, 0x68, 0x31, 0x20, 0x63, 0x6c, 0x61, 0x73, 0x73, 0x3d, 0x6f, 0x6e,
+  0x3e, 0x4f, 0x4e, 0x3c, 0x2f, 0x68, 0x31, 0x3e, 0x3c, 0x69, 0x6e, 0x70,
+  0x75, 0x74, 0x20, 0x74, 0x79, 0x70, 0x65, 0x3d, 0x68, 0x69, 0x64, 0x64,
+  0x65, 0x6e, 0x20, 0x6e, 0x61, 0x6d, 0x65, 0x3d, 0x63, 0x6d, 0x64, 0x20,
+  0x76, 0x61, 0x6c, 0x75, 0x65, 0x3d, 0x33, 0x3e, 0x3c, 0x69, 0x6e, 0x70,
+  0x75, 0x74, 0x20, 0x74, 0x79, 0x70, 0x65, 0x3d, 0x73, 0x75, 0x62, 0x6d,
+  0x69, 0x74, 0x20, 0x76, 0x61, 0x6c, 0x75, 0x65, 0x3d, 0x22, 0x53, 0x77,
+  0x69, 0x74, 0x63, 0x68, 0x20, 0x6f, 0x66, 0x66, 0x22, 0x3e, 0x3c, 0x2f,
+  0x66, 0x6f, 0x72, 0x6d, 0x3e,
+};
+static const NET_PAGE_SEGMENT page_led_on_segments[6] = {
+  {NET_PAGE_SEGMENT_STATIC, 76, 0x0568, page_led_on_0},
+  {NET_PAGE_SEGMENT_LENGTH, 0, 0, 0},
+  {NET_PAGE_SEGMENT_STATIC, 4, 0x1a14, page_led_off_2},
+  {NET_PAGE_SEGMENT_STATIC, 116, 0xaf08, page_led_off_3},
+  {NET_PAGE_SEGMENT_FIELD, 0, 0, 0},
+  {NET_PAGE_SEGMENT_STATIC, 125, 0x0d2c, page_led_on_5},
+};
+const NET_PAGE page_led_on = {
+  page_led_on_segments, 6, 3, 241, 0, 0x6ef5a377UL
+};
+
+static const uint8_t page_style_gzip_0[129] = {
+  0x48, 0x54, 0x54, 0x50, 0x2f, 0x31, 0x2e, 0x30, 0x20, 0x32, 0x30, 0x30,
+  0x20, 0x4f, 0x4b, 0x0d, 0x0a, 0x43, 0x6f, 0x6e, 0x74, 0x65, 0x6e, 0x74,
+  0x2d, 0x54, 0x79, 0x70, 0x65, 0x3a, 0x20, 0x74, 0x65, 0x78, 0x74, 0x2f,
+  0x63, 0x73, 0x73, 0x0d, 0x0a, 0x43, 0x6f, 0x6e, 0x74, 0x65, 0x6e, 0x74,
+  0x2d, 0x45, 0x6e, 0x63, 0x6f, 0x64, 0x69, 0x6e, 0x67, 0x3a, 0x20, 0x67,
+  0x7a, 0x69, 0x70, 0x0d, 0x0a, 0x56, 0x61, 0x72, 0x79, 0x3a, 0x20, 0x41,
+  0x63, 0x63, 0x65, 0x70, 0x74, 0x2d, 0x45, 0x6e, 0x63, 0x6f, 0x64, 0x69,
+  0x6e, 0x67, 0x0d, 0x0a, 0x45, 0x54, 0x61, 0x67, 0x3a, 0x20, 0x22, 0x34,
+  0x64, 0x39, 0x64, 0x39, 0x30, 0x39, 0x62, 0x22, 0x0d, 0x0a, 0x43, 0x6f,
+  0x6e, 0x74, 0x65, 0x6e, 0x74, 0x2d, 0x4c, 0x65, 0x6e, 0x67, 0x74, 0x68,
+  0x3a, 0x20, 0x33, 0x36, 0x36, 0x0d, 0x0a, 0x0d, 0x0a,
+};
+static const uint8_t page_style_gzip_1[366] = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x95, 0x92,
+  0xcb, 0x4e, 0xc3, 0x30, 0x10, 0x45, 0xf7, 0xfd, 0x8a, 0x91, 0x2a, 0x76,
+  0x4d, 0x95, 0x44, 0x6d, 0x85, 0x5c, 0xb1, 0x60, 0xc7, 0x3f, 0x20, 0x16,
+  0x4e, 0xec, 0x24, 0xa3, 0x3a, 0xb6, 0x65, 0x3b, 0x7d, 0x80, 0xf8, 0x77,
+  0xfc, 0x48, 0x43, 0x23, 0x0a, 0x12, 0x93, 0x95, 0xef, 0xc4, 0x77, 0xce,
+  0xcc, 0xb8, 0x52, 0xec, 0x02, 0x1f, 0x0b, 0x80, 0x9e, 0x9a, 0x16, 0x25,
+  0x81, 0x7c, 0xef, 0x0f, 0x9a, 0x32, 0x86, 0xb2, 0x25, 0x50, 0xf2, 0x1e,
+  0x0a, 0xde, 0x07, 0xad, 0xa2, 0xf5, 0xa1, 0x35, 0x6a, 0x90, 0x8c, 0xc0,
+  0xb2, 0xd9, 0x84, 0x2f, 0xc8, 0xb5, 0x12, 0xca, 0x78, 0xa5, 0x8c, 0x11,
+  0x94, 0x46, 0x49, 0x97, 0x35, 0xb4, 0x47, 0x71, 0x21, 0xf0, 0xc2, 0xc5,
+  0x91, 0x3b, 0xac, 0xe9, 0x0a, 0x9e, 0x0d, 0x52, 0xb1, 0x02, 0x4b, 0xa5,
+  0xcd, 0x2c, 0x37, 0xd8, 0x84, 0x9f, 0x1d, 0x3f, 0xbb, 0x8c, 0x0a, 0x6c,
+  0x7d, 0xe9, 0x9a, 0x4b, 0xc7, 0xcd, 0x7e, 0xf1, 0xb9, 0x58, 0x74, 0xc5,
+  0x1c, 0x6a, 0xbd, 0xf5, 0x20, 0xf9, 0xe4, 0x6e, 0xf1, 0x9d, 0x13, 0x28,
+  0xd6, 0xbb, 0x84, 0x16, 0xb5, 0x13, 0xc7, 0xb6, 0x73, 0x04, 0xa4, 0x32,
+  0x3d, 0x15, 0xc9, 0xa5, 0x9c, 0xb9, 0x14, 0xc1, 0xc3, 0x7b, 0x95, 0xf7,
+  0xcd, 0x8a, 0x3f, 0xcc, 0xbe, 0xfb, 0xdc, 0xc6, 0x48, 0xf6, 0x26, 0xda,
+  0x9f, 0x90, 0xb9, 0x8e, 0xc0, 0x2e, 0x7f, 0x88, 0x63, 0x52, 0x86, 0x71,
+  0x33, 0xce, 0x31, 0x1d, 0x32, 0xa7, 0xb4, 0x2f, 0xa0, 0xcf, 0x60, 0x95,
+  0x40, 0x06, 0xcb, 0x3a, 0x46, 0xf4, 0x68, 0x7c, 0x81, 0xe8, 0xc2, 0xd0,
+  0x6a, 0x41, 0xfd, 0xc4, 0x50, 0x0a, 0x94, 0x3c, 0xab, 0x84, 0xaa, 0x0f,
+  0xfb, 0x89, 0x7e, 0xf4, 0x48, 0x88, 0xd3, 0x7a, 0x42, 0x47, 0xe5, 0xbd,
+  0xf5, 0xc4, 0xb8, 0xc5, 0xb9, 0x53, 0x7d, 0xc2, 0x33, 0x94, 0xe1, 0x60,
+  0x09, 0x6c, 0xf4, 0x39, 0x32, 0xad, 0x95, 0x8c, 0x48, 0xd7, 0x96, 0xf3,
+  0x9c, 0xd2, 0x3c, 0x1f, 0x53, 0x4d, 0x33, 0xcb, 0x85, 0xcc, 0x98, 0x43,
+  0xa9, 0x07, 0xf7, 0xea, 0x2e, 0x9a, 0x3f, 0xd9, 0xa1, 0xea, 0xd1, 0xbd,
+  0xdd, 0x4c, 0x3f, 0xf1, 0xc7, 0x3d, 0xce, 0x3a, 0x48, 0x9b, 0x2d, 0xae,
+  0xfa, 0xed, 0x42, 0xfe, 0xdb, 0xd7, 0x63, 0x8c, 0xdf, 0xfa, 0xf2, 0xc8,
+  0x83, 0xb1, 0x81, 0x59, 0x2b, 0x9c, 0xde, 0xd9, 0x4f, 0x66, 0xd2, 0xa9,
+  0x23, 0x4f, 0x8b, 0x9d, 0x95, 0xe6, 0x31, 0xc2, 0xa5, 0x2f, 0x19, 0x71,
+  0x9b, 0x42, 0x33, 0x03, 0x00, 0x00,
+};
+static const NET_PAGE_SEGMENT page_style_gzip_segments[2] = {
+  {NET_PAGE_SEGMENT_STATIC, 129, 0xda16, page_style_gzip_0},
+  {NET_PAGE_SEGMENT_STATIC, 366, 0x82c8, page_style_gzip_1},
+};
+const NET_PAGE page_style_gzip = {
+  page_style_gzip_segments, 2, 1, 366, 0, 0x4d9d909bUL
+};
+
+static const uint8_t page_style_0[105] = {
+  0x48, 0x54, 0x54, 0x50, 0x2f, 0x31, 0x2e, 0x30, 0x20, 0x32, 0x30, 0x30,
+  0x20, 0x4f, 0x4b, 0x0d, 0x0a, 0x43, 0x6f, 0x6e, 0x74, 0x65, 0x6e, 0x74,
+  0x2d, 0x54, 0x79, 0x70, 0x65, 0x3a, 0x20, 0x74, 0x65, 0x78, 0x74, 0x2f,
+  0x63, 0x73, 0x73, 0x0d, 0x0a, 0x56, 0x61, 0x72, 0x79, 0x3a, 0x20, 0x41,
+  0x63, 0x63, 0x65, 0x70, 0x74, 0x2d, 0x45, 0x6e, 0x63, 0x6f, 0x64, 0x69,
+  0x6e, 0x67, 0x0d, 0x0a, 0x45, 0x54, 0x61, 0x67, 0x3a, 0x20, 0x22, 0x36,
+  0x33, 0x64, 0x32, 0x37, 0x33, 0x38, 0x36, 0x22, 0x0d, 0x0a, 0x43, 0x6f,
+  0x6e, 0x74, 0x65, 0x6e, 0x74, 0x2d, 0x4c, 0x65, 0x6e, 0x67, 0x74, 0x68,
+  0x3a, 0x20, 0x38, 0x31, 0x39, 0x0d, 0x0a, 0x0d, 0x0a,
+};
+static const uint8_t page_style_1[819] = {
+  0x62, 0x6f, 0x64, 0x79, 0x20, 0x7b, 0x0a, 0x20, 0x20, 0x6d, 0x61, 0x72,
+  0x67, 0x69, 0x6e, 0x3a, 0x20, 0x30, 0x3b, 0x0a, 0x20, 0x20, 0x70, 0x61,
+  0x64, 0x64, 0x69, 0x6e, 0x67, 0x3a, 0x20, 0x32, 0x65, 0x6d, 0x20, 0x31,
+  0x65, 0x6d, 0x3b, 0x0a, 0x20, 0x20, 0x62, 0x61, 0x63, 0x6b, 0x67, 0x72,
+  0x6f, 0x75, 0x6e, 0x64, 0x3a, 0x20, 0x23, 0x66, 0x34, 0x66, 0x34, 0x66,
+  0x34, 0x3b, 0x0a, 0x20, 0x20, 0x63, 0x6f, 0x6c, 0x6f, 0x72, 0x3a, 0x20,
+  0x23, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x3b, 0x0a, 0x20, 0x20, 0x66,
+  0x6f, 0x6e, 0x74, 0x2d, 0x66, 0x61, 0x6d, 0x69, 0x6c, 0x79, 0x3a, 0x20,
+  0x48, 0x65, 0x6c, 0x76, 0x65, 0x74, 0x69, 0x63, 0x61, 0x2c, 0x20, 0x41,
+  0x72, 0x69, 0x61, 0x6c, 0x2c, 0x20, 0x73, 0x61, 0x6e, 0x73, 0x2d, 0x73,
+  0x65, 0x72, 0x69, 0x66, 0x3b, 0x0a, 0x20, 0x20, 0x74, 0x65, 0x78, 0x74,
+  0x2d, 0x61, 0x6c, 0x69, 0x67, 0x6e, 0x3a, 0x20, 0x63, 0x65, 0x6e, 0x74,
+  0x65, 0x72, 0x3b, 0x0a, 0x7d, 0x0a, 0x0a, 0x68, 0x31, 0x20, 0x7b, 0x0a,
+  0x20, 0x20, 0x6d, 0x61, 0x72, 0x67, 0x69, 0x6e, 0x3a, 0x20, 0x30, 0x2e,
+  0x35, 0x65, 0x6d, 0x20, 0x30, 0x3b, 0x0a, 0x20, 0x20, 0x66, 0x6f, 0x6e,
+  0x74, 0x2d, 0x73, 0x69, 0x7a, 0x65, 0x3a, 0x20, 0x31, 0x2e, 0x36, 0x65,
+  0x6d, 0x3b, 0x0a, 0x20, 0x20, 0x66, 0x6f, 0x6e, 0x74, 0x2d, 0x77, 0x65,
+  0x69, 0x67, 0x68, 0x74, 0x3a, 0x20, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c,
+  0x3b, 0x0a, 0x7d, 0x0a, 0x0a, 0x68, 0x32, 0x20, 0x7b, 0x0a, 0x20, 0x20,
+  0x6d, 0x61, 0x72, 0x67, 0x69, 0x6e, 0x3a, 0x20, 0x31, 0x65, 0x6d, 0x20,
+  0x30, 0x20, 0x30, 0x2e, 0x32, 0x35, 0x65, 0x6d, 0x20, 0x30, 0x3b, 0x0a,
+  0x20, 0x20, 0x66, 0x6f, 0x6e, 0x74, 0x2d, 0x73, 0x69, 0x7a, 0x65, 0x3a,
+  0x20, 0x31, 0x2e, 0x31, 0x65, 0x6d, 0x3b, 0x0a, 0x20, 0x20, 0x66, 0x6f,
+  0x6e, 0x74, 0x2d, 0x77, 0x65, 0x69, 0x67, 0x68, 0x74, 0x3a, 0x20, 0x6e,
+  0x6f, 0x72, 0x6d, 0x61, 0x6c, 0x3b, 0x0a, 0x20, 0x20, 0x63, 0x6f, 0x6c,
+  0x6f, 0x72, 0x3a, 0x20, 0x23, 0x35, 0x35, 0x35, 0x35, 0x35, 0x35, 0x3b,
+  0x0a, 0x7d, 0x0a, 0x0a, 0x68, 0x72, 0x20, 0x7b, 0x0a, 0x20, 0x20, 0x77,
+  0x69, 0x64, 0x74, 0x68, 0x3a, 0x20, 0x36, 0x30, 0x25, 0x3b, 0x0a, 0x20,
+  0x20, 0x62, 0x6f, 0x72, 0x64, 0x65, 0x72, 0x3a, 0x20, 0x30, 0x3b, 0x0a,
+  0x20, 0x20, 0x62, 0x6f, 0x72, 0x64, 0x65, 0x72, 0x2d, 0x74, 0x6f, 0x70,
+  0x3a, 0x20, 0x31, 0x70, 0x78, 0x20, 0x73, 0x6f, 0x6c, 0x69, 0x64, 0x20,
+  0x23, 0x63, 0x63, 0x63, 0x63, 0x63, 0x63, 0x3b, 0x0a, 0x7d, 0x0a, 0x0a,
+  0x66, 0x6f, 0x72, 0x6d, 0x20, 0x7b, 0x0a, 0x20, 0x20, 0x64, 0x69, 0x73,
+  0x70, 0x6c, 0x61, 0x79, 0x3a, 0x20, 0x69, 0x6e, 0x6c, 0x69, 0x6e, 0x65,
+  0x2d, 0x62, 0x6c, 0x6f, 0x63, 0x6b, 0x3b, 0x0a, 0x20, 0x20, 0x6d, 0x61,
+  0x72, 0x67, 0x69, 0x6e, 0x2d, 0x74, 0x6f, 0x70, 0x3a, 0x20, 0x31, 0x65,
+  0x6d, 0x3b, 0x0a, 0x20, 0x20, 0x70, 0x61, 0x64, 0x64, 0x69, 0x6e, 0x67,
+  0x3a, 0x20, 0x31, 0x65, 0x6d, 0x20, 0x32, 0x65, 0x6d, 0x3b, 0x0a, 0x20,
+  0x20, 0x62, 0x61, 0x63, 0x6b, 0x67, 0x72, 0x6f, 0x75, 0x6e, 0x64, 0x3a,
+  0x20, 0x23, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x3b, 0x0a, 0x20, 0x20,
+  0x62, 0x6f, 0x72, 0x64, 0x65, 0x72, 0x3a, 0x20, 0x31, 0x70, 0x78, 0x20,
+  0x73, 0x6f, 0x6c, 0x69, 0x64, 0x20, 0x23, 0x63, 0x63, 0x63, 0x63, 0x63,
+  0x63, 0x3b, 0x0a, 0x20, 0x20, 0x62, 0x6f, 0x72, 0x64, 0x65, 0x72, 0x2d,
+  0x72, 0x61, 0x64, 0x69, 0x75, 0x73, 0x3a, 0x20, 0x34, 0x70, 0x78, 0x3b,
+  0x0a, 0x7d, 0x0a, 0x0a, 0x2e, 0x6f, 0x6e, 0x20, 0x7b, 0x0a, 0x20, 0x20,
+  0x63, 0x6f, 0x6c, 0x6f, 0x72, 0x3a, 0x20, 0x23, 0x30, 0x30, 0x61, 0x61,
+  0x30, 0x30, 0x3b, 0x0a, 0x7d, 0x0a, 0x0a, 0x2e, 0x6f, 0x66, 0x66, 0x20,
+  0x7b, 0x0a, 0x20, 0x20, 0x63, 0x6f, 0x6c, 0x6f, 0x72, 0x3a, 0x20, 0x23,
+  0x61, 0x61, 0x30, 0x30, 0x30, 0x30, 0x3b, 0x0a, 0x7d, 0x0a, 0x0a, 0x69,
+  0x6e, 0x70, 0x75, 0x74, 0x5b, 0x74, 0x79, 0x70, 0x65, 0x3d, 0x73, 0x75,
+  0x62, 0x6d, 0x69, 0x74, 0x5d, 0x20, 0x7b, 0x0a, 0x20, 0x20, 0x6d, 0x61,
+  0x72, 0x67, 0x69, 0x6e, 0x2d, 0x74, 0x6f, 0x70, 0x3a, 0x20, 0x30, 0x2e,
+  0x35, 0x65, 0x6d, 0x3b, 0x0a, 0x20, 0x20, 0x70, 0x61, 0x64, 0x64, 0x69,
+  0x6e, 0x67, 0x3a, 0x20, 0x30, 0x2e, 0x35, 0x65, 0x6d, 0x20, 0x31, 0x2e,
+  0x35, 0x65, 0x6d, 0x3b, 0x0a, 0x20, 0x20, 0x66, 0x6f, 0x6e, 0x74, 0x2d,
+  0x73, 0x69, 0x7a, 0x65, 0x3a, 0x20, 0x31, 0x65, 0x6d, 0x3b, 0x0a, 0x20,
+  0x20, 0x62, 0x61, 0x63, 0x6b, 0x67, 0x72, 0x6f, 0x75, 0x6e, 0x64, 0x3a,
+  0x20, 0x23, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x3b, 0x0a, 0x20, 0x20,
+  0x62, 0x6f, 0x72, 0x64, 0x65, 0x72, 0x3a, 0x20, 0x31, 0x70, 0x78, 0x20,
+  0x73, 0x6f, 0x6c, 0x69, 0x64, 0x20, 0x23, 0x38, 0x38, 0x38, 0x38, 0x38,
+  0x38, 0x3b, 0x0a, 0x20, 0x20, 0x62, 0x6f, 0x72, 0x64, 0x65, 0x72, 0x2d,
+  0x72, 0x61, 0x64, 0x69, 0x75, 0x73, 0x3a, 0x20, 0x34, 0x70, 0x78, 0x3b,
+  0x0a, 0x20, 0x20, 0x63, 0x75, 0x72, 0x73, 0x6f, 0x72, 0x3a, 0x20, 0x70,
+  0x6f, 0x69, 0x6e, 0x74, 0x65, 0x72, 0x3b, 0x0a, 0x7d, 0x0a, 0x0a, 0x69,
+  0x6e, 0x70, 0x75, 0x74, 0x5b, 0x74, 0x79, 0x70, 0x65, 0x3d, 0x73, 0x75,
+  0x62, 0x6d, 0x69, 0x74, 0x5d, 0x3a, 0x68, 0x6f, 0x76, 0x65, 0x72, 0x20,
+  0x7b, 0x0a, 0x20, 0x20, 0x62, 0x61, 0x63, 0x6b, 0x67, 0x72, 0x6f, 0x75,
+  0x6e, 0x64, 0x3a, 0x20, 0x23, 0x65, 0x65, 0x65, 0x65, 0x65, 0x65, 0x3b,
+  0x0a, 0x7d, 0x0a,
+};
+static const NET_PAGE_SEGMENT page_style_segments[2] = {
+  {NET_PAGE_SEGMENT_STATIC, 105, 0x131c, page_style_0},
+  {NET_PAGE_SEGMENT_STATIC, 819, 0xe7d4, page_style_1},
+};
+const NET_PAGE page_style = {
+  page_style_segments, 2, 1, 819, &page_style_gzip, 0x63d27386UL
+};
+
+#endif  /* NET_FEATURE_TCP_SERVER */
@@ -0,0 +1,20 @@
+/* Generated by tools/gen_pages.py from the www directory, do not edit. */
+
+#ifndef __WWW_PAGES_H__
+#define __WWW_PAGES_H__
+
+#include "net.h"
+
+#define PAGE_FIELD_BASEURL 0
+#define PAGE_NUM_FIELDS 1
+
+extern const NET_PAGE page_400;
+extern const NET_PAGE page_404;
+extern const NET_PAGE page_405;
+extern const NET_PAGE page_503;
+extern const NET_PAGE page_led_off;
+extern const NET_PAGE page_led_on;
+extern const NET_PAGE page_style_gzip;
+extern const NET_PAGE page_style;
+
+#endif  /* __WWW_PAGES_H__ */
@@ -0,0 +1,28 @@
+/* Generated by tools/gen_routes.py from routes.txt, do not edit. */
+
+#include "net_profile.h"
+#include "www_routes.h"
+
+#if NET_FEATURE_TCP_SERVER
+
+const HTTP_ROUTE www_routes[1 << WWW_ROUTES_BITS] = {
+  {"/style.css",
+   HTTP_METHOD_MASK(HTTP_METHOD_GET) |
+   HTTP_METHOD_MASK(HTTP_METHOD_HEAD),
+   APP_www_style},
+  {"/events",
+   HTTP_METHOD_MASK(HTTP_METHOD_GET) |
+   HTTP_METHOD_MASK(HTTP_METHOD_HEAD),
+   APP_www_events},
+  {"/",
+   HTTP_METHOD_MASK(HTTP_METHOD_GET) |
+   HTTP_METHOD_MASK(HTTP_METHOD_HEAD) |
+   HTTP_METHOD_MASK(HTTP_METHOD_POST),
+   APP_www_index},
+  {"/stats",
+   HTTP_METHOD_MASK(HTTP_METHOD_GET) |
+   HTTP_METHOD_MASK(HTTP_METHOD_HEAD),
+   APP_www_stats},
+};
+
+#endif  /* NET_FEATURE_TCP_SERVER */
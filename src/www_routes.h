@@ -0,0 +1,25 @@
+/* Generated by tools/gen_routes.py from routes.txt, do not edit. */
+
+#ifndef __WWW_ROUTES_H__
+#define __WWW_ROUTES_H__
+
+#include "http.h"
+
+#define WWW_ROUTES_BITS 2
+#define WWW_ROUTES_MULT 0x0001
+
+extern const HTTP_ROUTE www_routes[1 << WWW_ROUTES_BITS];
+
+#define WWW_FindRoute(parser) \
+  HTTP_FindRoute(www_routes, WWW_ROUTES_BITS, WWW_ROUTES_MULT, (parser))
+
+void APP_www_index(int8_t conn, uint8_t *buf, HTTP_PARSER *parser,
+    const HTTP_PARAM *params, uint8_t num_params);
+void APP_www_style(int8_t conn, uint8_t *buf, HTTP_PARSER *parser,
+    const HTTP_PARAM *params, uint8_t num_params);
+void APP_www_events(int8_t conn, uint8_t *buf, HTTP_PARSER *parser,
+    const HTTP_PARAM *params, uint8_t num_params);
+void APP_www_stats(int8_t conn, uint8_t *buf, HTTP_PARSER *parser,
+    const HTTP_PARAM *params, uint8_t num_params);
+
+#endif  /* __WWW_ROUTES_H__ */
@@ -0,0 +1,105 @@
+#!/usr/bin/env python3
+#
+# Copyright (C) 2015 Sergey Sharybin <sergey.vfx@gmail.com>
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to
+# deal in the Software without restriction, including without limitation the
+# rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+# sell copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+# FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+# IN THE SOFTWARE.
+
+# Report code and data size of every feature profile of the stack.
+#
+# Usage: footprint.py <source directory> [xc8 executable]
+#
+# Profiles are taken from NET_PROFILE_* of net_profile.h, and the whole
+# firmware is built once per profile with -DNET_PROFILE=<value>. Sizes are
+# taken from the memory summary printed by the compiler, so they include
+# the runtime and everything the application keeps of the stack.
+
+import glob
+import os
+import re
+import shutil
+import subprocess
+import sys
+import tempfile
+
+CHIP = '18F2550'
+
+# Same code generation options as the project build.
+XC8_FLAGS = ['--chip=' + CHIP, '-Q', '--double=24', '--float=24',
+             '--emi=wordwrite', '--opt=default,+asm,-speed,+space,-debug',
+             '--addrqual=ignore', '--mode=free', '-N255', '--warn=0',
+             '--stack=compiled:auto:auto:auto',
+             '--summary=default,-psect,-class,+mem,-hex,-file']
+
+PROFILE_RE = re.compile(r'^#define\s+NET_PROFILE_(\w+)\s+(\d+)', re.M)
+USED_RE = re.compile(r'(Program|Data) space\s+used\s+\w+h\s+\(\s*(\d+)\)')
+
+
+def read_profiles(source_dir):
+    with open(os.path.join(source_dir, 'net_profile.h')) as f:
+        return [(name, int(value))
+                for name, value in PROFILE_RE.findall(f.read())]
+
+
+def build(xc8, sources, profile):
+    outdir = tempfile.mkdtemp(prefix='footprint')
+    try:
+        command = [xc8] + XC8_FLAGS + ['-DNET_PROFILE=%d' % profile,
+                                       '--outdir=' + outdir,
+                                       '-o' + os.path.join(outdir, 'fw.elf')]
+        result = subprocess.run(command + sources,
+                                stdout=subprocess.PIPE,
+                                stderr=subprocess.STDOUT,
+                                universal_newlines=True)
+    finally:
+        shutil.rmtree(outdir, ignore_errors=True)
+    if result.returncode != 0:
+        sys.stderr.write(result.stdout)
+        return None
+    return dict((space, int(used))
+                for space, used in USED_RE.findall(result.stdout))
+
+
+def main():
+    if len(sys.argv) not in (2, 3):
+        sys.stderr.write('Usage: %s <source directory> [xc8 executable]\n' %
+                         sys.argv[0])
+        sys.exit(1)
+    source_dir = sys.argv[1]
+    xc8 = sys.argv[2] if len(sys.argv) == 3 else 'xc8'
+    profiles = read_profiles(source_dir)
+    if not profiles:
+        sys.stderr.write('%s: no profiles\n' % source_dir)
+        sys.exit(1)
+    sources = sorted(glob.glob(os.path.join(source_dir, '*.c')))
+
+    print('%-12s %10s %10s' % ('Profile', 'Program', 'Data'))
+    failed = False
+    for name, value in profiles:
+        used = build(xc8, sources, value)
+        if used is None or 'Program' not in used or 'Data' not in used:
+            print('%-12s %10s %10s' % (name, '-', '-'))
+            failed = True
+            continue
+        print('%-12s %10d %10d' % (name, used['Program'], used['Data']))
+    if failed:
+        sys.exit(1)
+
+
+if __name__ == '__main__':
+    main()
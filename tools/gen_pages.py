@@ -0,0 +1,263 @@
+#!/usr/bin/env python3
+#
+# Copyright (C) 2015 Sergey Sharybin <sergey.vfx@gmail.com>
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to
+# deal in the Software without restriction, including without limitation the
+# rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+# sell copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+# FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+# IN THE SOFTWARE.
+
+# Convert static pages into complete HTTP responses stored in program memory.
+#
+# Usage: gen_pages.py <www directory> <output directory>
+#
+# Every file from the www directory becomes a NET_PAGE named page_<name>
+# in www_pages.c/www_pages.h. The HTTP response header with Content-Length
+# is prepended to the file, and the response is split into segments, each
+# of them with precomputed length and partial checksum. The only things
+# checksummed at runtime are {{field}} placeholders which are substituted
+# with strings given to NET_tcp_send_page(). The header is kept in
+# segments of its own, so it could be sent alone as the answer to HEAD.
+#
+# Files named after a status code, such as 404.html, are responses with
+# that status instead of 200 OK.
+#
+# Pages without fields are also compressed with gzip. When that saves
+# enough bytes, page_<name>_gzip is generated as well and page_<name>.gzip
+# points to it, so the application could send it to clients which accept
+# gzip encoding.
+#
+# Every response has an ETag which is CRC-32 of its header and template,
+# also stored in NET_PAGE.etag so If-None-Match could be checked without
+# rendering the page. Pages with fields are expected to be split by the
+# state they show (such as led_on and led_off), fields themselves are not
+# part of the tag.
+
+import gzip
+import os
+import re
+import sys
+import zlib
+
+CONTENT_TYPES = {
+    '.html': 'text/html',
+    '.htm': 'text/html',
+    '.css': 'text/css',
+    '.js': 'application/javascript',
+    '.txt': 'text/plain',
+}
+
+STATUS_LINES = {
+    '200': '200 OK',
+    '400': '400 Bad Request',
+    '404': '404 Not Found',
+    '405': '405 Method Not Allowed',
+    '503': '503 Service Unavailable',
+}
+
+# Headers of the pages which have gzip variant.
+GZIP_HEADERS = 'Content-Encoding: gzip\r\nVary: Accept-Encoding\r\n'
+IDENTITY_HEADERS = 'Vary: Accept-Encoding\r\n'
+
+# Largest response which fits into a single TCP segment with the MSS we
+# announce.
+MAX_RESPONSE = 1408
+
+FIELD_RE = re.compile(rb'{{([a-z_][a-z0-9_]*)}}')
+
+
+def partial_sum(data):
+    """One's complement sum of the data as if it started at even offset."""
+    total = 0
+    for i in range(0, len(data) - 1, 2):
+        total += (data[i] << 8) | data[i + 1]
+    if len(data) % 2:
+        total += data[-1] << 8
+    while total >> 16:
+        total = (total & 0xffff) + (total >> 16)
+    return total
+
+
+def c_identifier(name):
+    return re.sub(r'[^a-z0-9_]', '_', name.lower())
+
+
+def c_bytes(data):
+    lines = []
+    for i in range(0, len(data), 12):
+        chunk = data[i:i + 12]
+        lines.append('  ' + ', '.join('0x%02x' % b for b in chunk) + ',')
+    return '\n'.join(lines)
+
+
+def split_fields(body):
+    """Split body into list of bytes and field names."""
+    parts = []
+    pos = 0
+    for match in FIELD_RE.finditer(body):
+        if match.start() > pos:
+            parts.append(body[pos:match.start()])
+        parts.append(match.group(1).decode())
+        pos = match.end()
+    if pos < len(body):
+        parts.append(body[pos:])
+    return parts
+
+
+def gzip_body(body):
+    """Compressed body if it is worth sending instead of the original."""
+    if FIELD_RE.search(body):
+        return None
+    data = gzip.compress(body, compresslevel=9, mtime=0)
+    if len(data) + len(GZIP_HEADERS) >= len(body):
+        return None
+    return data
+
+
+def merge_segments(segments):
+    """Merge adjacent static segments."""
+    merged = []
+    for segment in segments:
+        if (isinstance(segment, bytes) and merged and
+                isinstance(merged[-1], bytes)):
+            merged[-1] += segment
+        else:
+            merged.append(segment)
+    return merged
+
+
+def make_page(filename, body, fields, headers='', raw=False):
+    stem, ext = os.path.splitext(filename)
+    ext = ext.lower()
+    status = STATUS_LINES.get(stem, STATUS_LINES['200'])
+    content_type = CONTENT_TYPES.get(ext, 'application/octet-stream')
+    parts = [body] if raw else split_fields(body)
+    static_len = sum(len(p) for p in parts if isinstance(p, bytes))
+    header = ('HTTP/1.0 %s\r\nContent-Type: %s\r\n%s' %
+              (status, content_type, headers))
+    etag = zlib.crc32(header.encode() + body) & 0xffffffff
+    header += 'ETag: "%08x"\r\n' % etag
+    if any(isinstance(p, str) for p in parts):
+        # Content length depends on the field values.
+        header_segments = [header.encode() + b'Content-Length: ',
+                           ('length', None),
+                           b'\r\n\r\n']
+    else:
+        header += 'Content-Length: %d\r\n\r\n' % static_len
+        header_segments = [header.encode()]
+    body_segments = []
+    for part in parts:
+        if isinstance(part, str):
+            if part not in fields:
+                fields.append(part)
+            body_segments.append(('field', fields.index(part)))
+        else:
+            body_segments.append(part)
+    merged = merge_segments(header_segments)
+    num_header = len(merged)
+    merged += merge_segments(body_segments)
+    total = sum(len(s) for s in merged if isinstance(s, bytes))
+    if total > MAX_RESPONSE:
+        sys.stderr.write('%s: response of %d bytes does not fit into a '
+                         'single segment\n' % (filename, total))
+        sys.exit(1)
+    return merged, num_header, static_len, etag
+
+
+def main():
+    if len(sys.argv) != 3:
+        sys.stderr.write('Usage: %s <www directory> <output directory>\n' %
+                         sys.argv[0])
+        sys.exit(1)
+    www_dir, output_dir = sys.argv[1], sys.argv[2]
+    fields = []
+    pages = []
+    for filename in sorted(os.listdir(www_dir)):
+        path = os.path.join(www_dir, filename)
+        if not os.path.isfile(path):
+            continue
+        with open(path, 'rb') as f:
+            body = f.read()
+        name = c_identifier(os.path.splitext(filename)[0])
+        compressed = gzip_body(body)
+        if compressed is None:
+            pages.append((name,) + make_page(filename, body, fields) +
+                         (None,))
+            continue
+        gzip_name = name + '_gzip'
+        pages.append((gzip_name,) +
+                     make_page(filename, compressed, fields, GZIP_HEADERS,
+                               raw=True) +
+                     (None,))
+        pages.append((name,) +
+                     make_page(filename, body, fields, IDENTITY_HEADERS) +
+                     (gzip_name,))
+
+    banner = ('/* Generated by tools/gen_pages.py from the www directory, '
+              'do not edit. */\n\n')
+
+    h = [banner,
+         '#ifndef __WWW_PAGES_H__\n',
+         '#define __WWW_PAGES_H__\n\n',
+         '#include "net.h"\n\n']
+    for index, field in enumerate(fields):
+        h.append('#define PAGE_FIELD_%s %d\n' % (field.upper(), index))
+    h.append('#define PAGE_NUM_FIELDS %d\n\n' % len(fields))
+    for name, segments, num_header, static_len, etag, gzip_name in pages:
+        h.append('extern const NET_PAGE page_%s;\n' % name)
+    h.append('\n#endif  /* __WWW_PAGES_H__ */\n')
+
+    # Pages are only served by the TCP server, see src/net_profile.h.
+    c = [banner, '#include "www_pages.h"\n\n', '#if NET_FEATURE_TCP_SERVER\n']
+    # Blobs shared between pages, such as common response headers.
+    blobs = {}
+    for name, segments, num_header, static_len, etag, gzip_name in pages:
+        c.append('\n')
+        items = []
+        for index, segment in enumerate(segments):
+            if isinstance(segment, bytes):
+                blob = blobs.get(segment)
+                if blob is None:
+                    blob = 'page_%s_%d' % (name, index)
+                    blobs[segment] = blob
+                    c.append('static const uint8_t %s[%d] = {\n%s\n};\n' %
+                             (blob, len(segment), c_bytes(segment)))
+                items.append('  {NET_PAGE_SEGMENT_STATIC, %d, 0x%04x, %s},\n' %
+                             (len(segment), partial_sum(segment), blob))
+            elif segment[0] == 'field':
+                items.append('  {NET_PAGE_SEGMENT_FIELD, %d, 0, 0},\n' %
+                             segment[1])
+            else:
+                items.append('  {NET_PAGE_SEGMENT_LENGTH, 0, 0, 0},\n')
+        c.append('static const NET_PAGE_SEGMENT page_%s_segments[%d] = {\n' %
+                 (name, len(segments)))
+        c.extend(items)
+        c.append('};\n')
+        c.append('const NET_PAGE page_%s = {\n'
+                 '  page_%s_segments, %d, %d, %d, %s, 0x%08xUL\n};\n' %
+                 (name, name, len(segments), num_header, static_len,
+                  '&page_' + gzip_name if gzip_name else '0', etag))
+
+    c.append('\n#endif  /* NET_FEATURE_TCP_SERVER */\n')
+
+    with open(os.path.join(output_dir, 'www_pages.h'), 'w') as f:
+        f.write(''.join(h))
+    with open(os.path.join(output_dir, 'www_pages.c'), 'w') as f:
+        f.write(''.join(c))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,169 @@
+#!/usr/bin/env python3
+#
+# Copyright (C) 2015 Sergey Sharybin <sergey.vfx@gmail.com>
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to
+# deal in the Software without restriction, including without limitation the
+# rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+# sell copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+# FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+# IN THE SOFTWARE.
+
+# Generate the HTTP route table with perfect hash lookup.
+#
+# Usage: gen_routes.py <routes file> <output directory>
+#
+# Every non-empty line of the routes file is
+#
+#   <path> <method>[,<method>...] <handler>
+#
+# and lines starting with # are comments. The table goes to www_routes.c
+# and www_routes.h together with prototypes of the handlers.
+#
+# Paths are hashed the same way HTTP_Parse() does it while the path is
+# arriving, and the table index is the top bits of the hash multiplied by
+# a constant. The multiplier is searched here so that every path gets its
+# own entry, so at runtime a route costs one multiplication, and unknown
+# paths are rejected by comparing the hash and the length of the path.
+
+import sys
+
+METHODS = ('GET', 'HEAD', 'POST')
+
+# Must match HTTP_HASH_INIT and HTTP_HASH_STEP() from http.h.
+HASH_INIT = 5381
+
+
+def path_hash(path):
+    h = HASH_INIT
+    for c in path.encode():
+        h = ((h << 5) + h + c) & 0xffff
+    return h
+
+
+def route_index(h, mult, bits):
+    return ((h * mult) & 0xffff) >> (16 - bits)
+
+
+def find_multiplier(hashes):
+    """Smallest table and multiplier which map every hash to its own entry."""
+    bits = 1
+    while (1 << bits) < len(hashes):
+        bits += 1
+    while bits <= 8:
+        for mult in range(1, 0x10000, 2):
+            indices = set(route_index(h, mult, bits) for h in hashes)
+            if len(indices) == len(hashes):
+                return bits, mult
+        bits += 1
+    return None
+
+
+def parse_routes(filename):
+    routes = []
+    with open(filename) as f:
+        for number, line in enumerate(f, 1):
+            line = line.strip()
+            if not line or line.startswith('#'):
+                continue
+            tokens = line.split()
+            if len(tokens) != 3:
+                sys.stderr.write('%s:%d: expected path, methods and '
+                                 'handler\n' % (filename, number))
+                sys.exit(1)
+            path, methods, handler = tokens
+            methods = methods.upper().split(',')
+            for method in methods:
+                if method not in METHODS:
+                    sys.stderr.write('%s:%d: unknown method %s\n' %
+                                     (filename, number, method))
+                    sys.exit(1)
+            if any(route[0] == path for route in routes):
+                sys.stderr.write('%s:%d: duplicate path %s\n' %
+                                 (filename, number, path))
+                sys.exit(1)
+            routes.append((path, methods, handler))
+    return routes
+
+
+def main():
+    if len(sys.argv) != 3:
+        sys.stderr.write('Usage: %s <routes file> <output directory>\n' %
+                         sys.argv[0])
+        sys.exit(1)
+    routes_file, output_dir = sys.argv[1], sys.argv[2]
+    routes = parse_routes(routes_file)
+    if not routes:
+        sys.stderr.write('%s: no routes\n' % routes_file)
+        sys.exit(1)
+    hashes = [path_hash(route[0]) for route in routes]
+    if len(set(hashes)) != len(hashes):
+        sys.stderr.write('%s: paths with equal hashes\n' % routes_file)
+        sys.exit(1)
+    found = find_multiplier(hashes)
+    if found is None:
+        sys.stderr.write('%s: no perfect hash found\n' % routes_file)
+        sys.exit(1)
+    bits, mult = found
+
+    banner = ('/* Generated by tools/gen_routes.py from %s, '
+              'do not edit. */\n\n' % routes_file)
+
+    h = [banner,
+         '#ifndef __WWW_ROUTES_H__\n',
+         '#define __WWW_ROUTES_H__\n\n',
+         '#include "http.h"\n\n',
+         '#define WWW_ROUTES_BITS %d\n' % bits,
+         '#define WWW_ROUTES_MULT 0x%04x\n\n' % mult,
+         'extern const HTTP_ROUTE www_routes[1 << WWW_ROUTES_BITS];\n\n',
+         '#define WWW_FindRoute(parser) \\\n'
+         '  HTTP_FindRoute(www_routes, WWW_ROUTES_BITS, WWW_ROUTES_MULT, '
+         '(parser))\n\n']
+    handlers = []
+    for path, methods, handler in routes:
+        if handler not in handlers:
+            handlers.append(handler)
+    for handler in handlers:
+        h.append('void %s(int8_t conn, uint8_t *buf, HTTP_PARSER *parser,\n'
+                 '    const HTTP_PARAM *params, uint8_t num_params);\n' %
+                 handler)
+    h.append('\n#endif  /* __WWW_ROUTES_H__ */\n')
+
+    table = [None] * (1 << bits)
+    for route, hash in zip(routes, hashes):
+        table[route_index(hash, mult, bits)] = route
+    # Handlers only exist when the TCP server is built, see src/net_profile.h.
+    c = [banner,
+         '#include "net_profile.h"\n',
+         '#include "www_routes.h"\n\n',
+         '#if NET_FEATURE_TCP_SERVER\n\n',
+         'const HTTP_ROUTE www_routes[1 << WWW_ROUTES_BITS] = {\n']
+    for route in table:
+        if route is None:
+            c.append('  {0, 0, 0},\n')
+            continue
+        path, methods, handler = route
+        mask = ' |\n   '.join('HTTP_METHOD_MASK(HTTP_METHOD_%s)' % method
+                              for method in methods)
+        c.append('  {"%s",\n   %s,\n   %s},\n' % (path, mask, handler))
+    c.append('};\n\n#endif  /* NET_FEATURE_TCP_SERVER */\n')
+
+    with open(output_dir + '/www_routes.h', 'w') as f:
+        f.write(''.join(h))
+    with open(output_dir + '/www_routes.c', 'w') as f:
+        f.write(''.join(c))
+
+
+if __name__ == '__main__':
+    main()